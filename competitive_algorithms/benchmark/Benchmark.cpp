@@ -0,0 +1,218 @@
+#include <chrono>
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "../competitiveProgAlgoLib/Array.h"
+#include "../competitiveProgAlgoLib/SparseTable.h"
+#include "../competitiveProgAlgoLib/SegmentTree.h"
+#include "../competitiveProgAlgoLib/FenwickTree.h"
+#include "../competitiveProgAlgoLib/SqrtDecomposer.h"
+#include "../competitiveProgAlgoLib/Treap.h"
+
+#if defined(_WIN32)
+#define PSAPI_VERSION 2
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+using value_type = long long;
+using function_type = cpa::Min<value_type>;
+using clock_type = std::chrono::steady_clock;
+
+struct operation {
+    bool update;
+    std::size_t left;
+    std::size_t right;
+    value_type value;
+};
+
+struct distribution {
+    const char *name;
+    std::size_t (*min_length)(std::size_t);
+    std::size_t (*max_length)(std::size_t);
+};
+
+struct mix {
+    const char *name;
+    unsigned int update_percent;
+};
+
+struct measurement {
+    double build_ns = 0;
+    double query_ns = 0;
+    double update_ns = 0;
+    std::size_t queries = 0;
+    std::size_t updates = 0;
+    value_type checksum = 0;
+};
+
+void resetPeakRss() {
+#if defined(__linux__)
+    std::ofstream("/proc/self/clear_refs") << "5";
+#endif
+}
+
+std::size_t peakRss() {
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return counters.PeakWorkingSetSize;
+    }
+    return 0;
+#else
+#if defined(__linux__)
+    std::ifstream status("/proc/self/status");
+    for (std::string line; std::getline(status, line);) {
+        if (line.compare(0, 6, "VmHWM:") == 0) {
+            return std::strtoull(line.c_str() + 6, nullptr, 10) * 1024;
+        }
+    }
+#endif
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+#if defined(__APPLE__)
+    return usage.ru_maxrss;
+#else
+    return static_cast<std::size_t>(usage.ru_maxrss) * 1024;
+#endif
+#endif
+}
+
+double elapsedNs(clock_type::time_point t_begin) {
+    return std::chrono::duration<double, std::nano>(clock_type::now() - t_begin).count();
+}
+
+std::vector<operation> generateOperations(std::size_t t_size, const distribution &t_distribution,
+                                          const mix &t_mix, std::size_t t_count, std::mt19937_64 &t_rnd) {
+    std::vector<operation> operations(t_count);
+    auto max_length = std::min(t_size, t_distribution.max_length(t_size));
+    auto min_length = std::max<std::size_t>(1, std::min(max_length, t_distribution.min_length(t_size)));
+    for (auto &op : operations) {
+        op.update = t_rnd() % 100 < t_mix.update_percent;
+        op.value = static_cast<value_type>(t_rnd() % 2000001) - 1000000;
+        auto length = min_length + t_rnd() % (max_length - min_length + 1);
+        op.left = t_rnd() % (t_size - length + 1);
+        op.right = op.left + length - 1;
+    }
+    return operations;
+}
+
+template<class TSolver>
+measurement run(const std::vector<value_type> &t_data, const std::vector<operation> &t_operations,
+                double t_budget_ns) {
+    constexpr std::size_t chunk_size = 256;
+    measurement result;
+    auto begin = clock_type::now();
+    TSolver solver(t_data.begin(), t_data.end());
+    result.build_ns = elapsedNs(begin);
+    result.checksum = solver.valueOnSegment(0, t_data.size() - 1);
+    for (std::size_t from = 0; from < t_operations.size() && result.query_ns + result.update_ns < t_budget_ns;
+         from += chunk_size) {
+        auto to = std::min(from + chunk_size, t_operations.size());
+        begin = clock_type::now();
+        for (auto i = from; i < to; ++i) {
+            if (!t_operations[i].update) {
+                result.checksum += solver.valueOnSegment(t_operations[i].left, t_operations[i].right);
+                ++result.queries;
+            }
+        }
+        result.query_ns += elapsedNs(begin);
+        if constexpr (std::is_base_of_v<cpa::IMutableDataStructure<TSolver, value_type>, TSolver>) {
+            begin = clock_type::now();
+            for (auto i = from; i < to; ++i) {
+                if (t_operations[i].update) {
+                    solver.changeValueAt(t_operations[i].right, t_operations[i].value);
+                    ++result.updates;
+                }
+            }
+            result.update_ns += elapsedNs(begin);
+        }
+    }
+    return result;
+}
+
+void report(bool &t_first, const char *t_structure, std::size_t t_size, const distribution &t_distribution,
+            const mix &t_mix, const measurement *t_measurement) {
+    std::cout << (t_first ? "" : ",") << "\n  {\"structure\": \"" << t_structure << "\", \"size\": " << t_size
+              << ", \"ranges\": \"" << t_distribution.name << "\", \"mix\": \"" << t_mix.name << "\", ";
+    t_first = false;
+    if (t_measurement == nullptr) {
+        std::cout << "\"error\": \"out of memory\"}";
+        return;
+    }
+    auto &m = *t_measurement;
+    std::cout << "\"build_ns\": " << static_cast<long long>(m.build_ns)
+              << ", \"queries\": " << m.queries
+              << ", \"ns_per_query\": " << (m.queries == 0 ? 0.0 : m.query_ns / m.queries)
+              << ", \"updates\": " << m.updates
+              << ", \"ns_per_update\": " << (m.updates == 0 ? 0.0 : m.update_ns / m.updates)
+              << ", \"peak_rss_bytes\": " << peakRss()
+              << ", \"checksum\": " << m.checksum << "}";
+}
+
+template<class TSolver>
+void benchmark(bool &t_first, const char *t_structure, const std::vector<value_type> &t_data,
+               const distribution &t_distribution, const mix &t_mix, const std::vector<operation> &t_operations,
+               double t_budget_ns) {
+    resetPeakRss();
+    try {
+        auto result = run<TSolver>(t_data, t_operations, t_budget_ns);
+        report(t_first, t_structure, t_data.size(), t_distribution, t_mix, &result);
+    } catch (const std::bad_alloc &) {
+        report(t_first, t_structure, t_data.size(), t_distribution, t_mix, nullptr);
+    }
+}
+
+int main(int argc, char **argv) {
+    std::size_t max_size = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+    double budget_ns = (argc > 2 ? std::strtod(argv[2], nullptr) : 200.0) * 1e6;
+    std::size_t operation_count = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 1u << 20u;
+    const distribution distributions[] = {
+            {"short", [](std::size_t) -> std::size_t { return 1; }, [](std::size_t) -> std::size_t { return 16; }},
+            {"uniform", [](std::size_t) -> std::size_t { return 1; }, [](std::size_t n) { return n; }},
+            {"long", [](std::size_t n) { return n / 2; }, [](std::size_t n) { return n; }},
+    };
+    const mix mixes[] = {
+            {"read_only", 0},
+            {"balanced", 50},
+            {"write_heavy", 90},
+    };
+    std::mt19937_64 rnd(42);
+    bool first = true;
+    std::cout << "[";
+    for (std::size_t size = 1000; size <= max_size; size *= 10) {
+        std::vector<value_type> data(size);
+        for (auto &val : data) {
+            val = static_cast<value_type>(rnd() % 2000001) - 1000000;
+        }
+        for (auto &dist : distributions) {
+            for (auto &mx : mixes) {
+                auto operations = generateOperations(size, dist, mx, operation_count, rnd);
+                benchmark<cpa::Array<value_type, function_type>>(
+                        first, "Array", data, dist, mx, operations, budget_ns);
+                if (mx.update_percent == 0) {
+                    benchmark<cpa::SparseTable<value_type, function_type>>(
+                            first, "SparseTable", data, dist, mx, operations, budget_ns);
+                }
+                benchmark<cpa::SegmentTree<value_type, function_type>>(
+                        first, "SegmentTree", data, dist, mx, operations, budget_ns);
+                benchmark<cpa::FenwickTree<value_type, function_type>>(
+                        first, "FenwickTree", data, dist, mx, operations, budget_ns);
+                benchmark<cpa::SqrtDecomposer<value_type, function_type>>(
+                        first, "SqrtDecomposer", data, dist, mx, operations, budget_ns);
+                benchmark<cpa::Treap<value_type, function_type>>(
+                        first, "Treap", data, dist, mx, operations, budget_ns);
+            }
+        }
+    }
+    std::cout << "\n]" << std::endl;
+    return 0;
+}
@@ -0,0 +1,299 @@
+#ifndef COMPETITIVE_ALGORITHMS_ADAPTIVESEGMENTSOLVER_H
+#define COMPETITIVE_ALGORITHMS_ADAPTIVESEGMENTSOLVER_H
+
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+#include "IMutableDataStructure.h"
+#include "ISegmentSolver.h"
+#include "Array.h"
+#include "SparseTable.h"
+#include "DisjointSparseTable.h"
+#include "SegmentTree.h"
+#include "FenwickTree.h"
+#include "SqrtDecomposer.h"
+
+namespace cpa {
+
+    enum class SolverKind {
+        Array,
+        SparseTable,
+        DisjointSparseTable,
+        SegmentTree,
+        FenwickTree,
+        SqrtDecomposer
+    };
+
+    template<class TFunction>
+    SolverKind chooseSolverKind(std::size_t t_size, double t_update_ratio, double t_average_length) noexcept {
+        constexpr std::size_t small_size = 64;
+        constexpr double short_length = 32;
+        constexpr double update_heavy_ratio = 0.9;
+        using traits = MonoidTraits<TFunction>;
+        if (t_size <= small_size) {
+            return SolverKind::Array;
+        }
+        if (t_update_ratio <= 0) {
+            return traits::idempotent ? SolverKind::SparseTable : SolverKind::DisjointSparseTable;
+        }
+        if (t_average_length <= short_length) {
+            return SolverKind::Array;
+        }
+        if (!traits::commutative || (traits::invertible && t_update_ratio >= update_heavy_ratio)) {
+            return SolverKind::SqrtDecomposer;
+        }
+        return traits::invertible ? SolverKind::FenwickTree : SolverKind::SegmentTree;
+    }
+
+    template<class TType, class TFunction = std::function<TType(const TType &, const TType &)>>
+    class AdaptiveSegmentSolver :
+            public IMutableDataStructure<AdaptiveSegmentSolver<TType, TFunction>, TType>,
+            public ISegmentSolver<AdaptiveSegmentSolver<TType, TFunction>, TType, TFunction> {
+    private:
+        using solver_type = std::variant<
+                Array<TType, TFunction>,
+                SparseTable<TType, TFunction>,
+                DisjointSparseTable<TType, TFunction>,
+                SegmentTree<TType, TFunction>,
+                FenwickTree<TType, TFunction>,
+                SqrtDecomposer<TType, TFunction>>;
+
+        static constexpr std::size_t min_window = 1024;
+
+        solver_type m_solver;
+        bool m_adaptive = true;
+        std::size_t m_queries = 0;
+        std::size_t m_updates = 0;
+        double m_total_length = 0;
+        std::size_t m_migrations = 0;
+
+        [[nodiscard]] std::size_t window() const noexcept;
+
+        [[nodiscard]] double updateRatio() const noexcept;
+
+        [[nodiscard]] double averageLength() const noexcept;
+
+        void retune();
+
+        template<class TIter>
+        void build(SolverKind t_kind, TIter t_begin, TIter t_end);
+
+    public:
+        explicit AdaptiveSegmentSolver(const TFunction &t_function = TFunction());
+
+        template<class TIter>
+        AdaptiveSegmentSolver(TIter t_begin, TIter t_end, const TFunction &t_function = TFunction(),
+                              double t_update_ratio = 0, double t_average_length = 0);
+
+        AdaptiveSegmentSolver(const AdaptiveSegmentSolver<TType, TFunction> &other) = default;
+
+        AdaptiveSegmentSolver(AdaptiveSegmentSolver<TType, TFunction> &&other) = default;
+
+        [[nodiscard]] SolverKind kind() const noexcept;
+
+        [[nodiscard]] std::size_t migrations() const noexcept;
+
+        void setAdaptive(bool t_adaptive) noexcept;
+
+        void rebuild(SolverKind t_kind);
+
+        TType getValueAt(std::size_t t_index) const;
+
+        void changeValueAt(std::size_t t_index, const TType &t_value);
+
+        TType valueOnSegment(std::size_t t_left_index, std::size_t t_right_index);
+
+        TType valueOnSegment(std::size_t t_left_index, std::size_t t_right_index) const;
+
+        void valueOnSegments(const std::vector<std::pair<std::size_t, std::size_t>> &t_queries,
+                             std::vector<TType> &t_result);
+
+        void valueOnSegments(const std::vector<std::pair<std::size_t, std::size_t>> &t_queries,
+                             std::vector<TType> &t_result) const;
+    };
+
+    template<class TType, class TFunction, class TIter>
+    AdaptiveSegmentSolver<TType, TFunction> makeSegmentSolver(TIter t_begin, TIter t_end,
+                                                              const TFunction &t_function = TFunction(),
+                                                              double t_update_ratio = 0,
+                                                              double t_average_length = 0) {
+        return AdaptiveSegmentSolver<TType, TFunction>(t_begin, t_end, t_function, t_update_ratio, t_average_length);
+    }
+
+    template<class TType, class TFunction>
+    AdaptiveSegmentSolver<TType, TFunction>::AdaptiveSegmentSolver(const TFunction &t_function) :
+            m_solver(std::in_place_type<Array<TType, TFunction>>, t_function) {
+        this->m_function = t_function;
+    }
+
+    template<class TType, class TFunction>
+    template<class TIter>
+    AdaptiveSegmentSolver<TType, TFunction>::AdaptiveSegmentSolver(TIter t_begin, TIter t_end,
+                                                                   const TFunction &t_function,
+                                                                   double t_update_ratio,
+                                                                   double t_average_length) :
+            m_solver(std::in_place_type<Array<TType, TFunction>>, t_function) {
+        this->m_function = t_function;
+        this->m_size = std::distance(t_begin, t_end);
+        if (t_average_length <= 0) {
+            t_average_length = static_cast<double>(this->m_size) / 3;
+        }
+        this->build(chooseSolverKind<TFunction>(this->m_size, t_update_ratio, t_average_length), t_begin, t_end);
+    }
+
+    template<class TType, class TFunction>
+    template<class TIter>
+    void AdaptiveSegmentSolver<TType, TFunction>::build(SolverKind t_kind, TIter t_begin, TIter t_end) {
+        switch (t_kind) {
+            case SolverKind::SparseTable:
+                this->m_solver.template emplace<SparseTable<TType, TFunction>>(t_begin, t_end, this->m_function);
+                break;
+            case SolverKind::DisjointSparseTable:
+                this->m_solver.template emplace<DisjointSparseTable<TType, TFunction>>(t_begin, t_end,
+                                                                                      this->m_function);
+                break;
+            case SolverKind::FenwickTree:
+                if constexpr (MonoidTraits<TFunction>::invertible) {
+                    this->m_solver.template emplace<FenwickTree<TType, TFunction>>(t_begin, t_end,
+                                                                                  this->m_function);
+                    break;
+                }
+                [[fallthrough]];
+            case SolverKind::SegmentTree:
+                this->m_solver.template emplace<SegmentTree<TType, TFunction>>(t_begin, t_end, this->m_function);
+                break;
+            case SolverKind::SqrtDecomposer:
+                this->m_solver.template emplace<SqrtDecomposer<TType, TFunction>>(t_begin, t_end, this->m_function);
+                break;
+            default:
+                this->m_solver.template emplace<Array<TType, TFunction>>(t_begin, t_end, this->m_function);
+                break;
+        }
+    }
+
+    template<class TType, class TFunction>
+    SolverKind AdaptiveSegmentSolver<TType, TFunction>::kind() const noexcept {
+        return static_cast<SolverKind>(this->m_solver.index());
+    }
+
+    template<class TType, class TFunction>
+    std::size_t AdaptiveSegmentSolver<TType, TFunction>::migrations() const noexcept {
+        return this->m_migrations;
+    }
+
+    template<class TType, class TFunction>
+    void AdaptiveSegmentSolver<TType, TFunction>::setAdaptive(bool t_adaptive) noexcept {
+        this->m_adaptive = t_adaptive;
+    }
+
+    template<class TType, class TFunction>
+    std::size_t AdaptiveSegmentSolver<TType, TFunction>::window() const noexcept {
+        return std::max(min_window, this->m_size);
+    }
+
+    template<class TType, class TFunction>
+    double AdaptiveSegmentSolver<TType, TFunction>::updateRatio() const noexcept {
+        auto total = this->m_queries + this->m_updates;
+        return total == 0 ? 0 : static_cast<double>(this->m_updates) / static_cast<double>(total);
+    }
+
+    template<class TType, class TFunction>
+    double AdaptiveSegmentSolver<TType, TFunction>::averageLength() const noexcept {
+        return this->m_queries == 0 ? static_cast<double>(this->m_size) / 3 :
+               this->m_total_length / static_cast<double>(this->m_queries);
+    }
+
+    template<class TType, class TFunction>
+    void AdaptiveSegmentSolver<TType, TFunction>::rebuild(SolverKind t_kind) {
+        if (t_kind == this->kind()) {
+            return;
+        }
+        std::vector<TType> values;
+        values.reserve(this->m_size);
+        for (std::size_t i = 0; i < this->m_size; ++i) {
+            values.push_back(this->getValueAt(i));
+        }
+        this->build(t_kind, values.begin(), values.end());
+        ++this->m_migrations;
+    }
+
+    template<class TType, class TFunction>
+    void AdaptiveSegmentSolver<TType, TFunction>::retune() {
+        if (!this->m_adaptive || this->m_queries + this->m_updates < this->window()) {
+            return;
+        }
+        this->rebuild(chooseSolverKind<TFunction>(this->m_size, this->updateRatio(), this->averageLength()));
+        this->m_queries = 0;
+        this->m_updates = 0;
+        this->m_total_length = 0;
+    }
+
+    template<class TType, class TFunction>
+    TType AdaptiveSegmentSolver<TType, TFunction>::getValueAt(std::size_t t_index) const {
+        return std::visit([t_index](const auto &t_solver) -> TType {
+            return t_solver.getValueAt(t_index);
+        }, this->m_solver);
+    }
+
+    template<class TType, class TFunction>
+    void AdaptiveSegmentSolver<TType, TFunction>::changeValueAt(std::size_t t_index, const TType &t_value) {
+        ++this->m_updates;
+        if (this->kind() == SolverKind::SparseTable || this->kind() == SolverKind::DisjointSparseTable) {
+            this->rebuild(chooseSolverKind<TFunction>(this->m_size, this->updateRatio(), this->averageLength()));
+        }
+        std::visit([&](auto &t_solver) {
+            using solver = std::decay_t<decltype(t_solver)>;
+            if constexpr (std::is_same_v<solver, FenwickTree<TType, TFunction>>) {
+                if constexpr (MonoidTraits<TFunction>::invertible) {
+                    t_solver.changeValueAt(t_index, this->m_function(t_value,
+                                                                     TFunction::inverse(t_solver.getValueAt(t_index))));
+                }
+            } else if constexpr (std::is_base_of_v<IMutableDataStructure<solver, TType>, solver>) {
+                t_solver.changeValueAt(t_index, t_value);
+            }
+        }, this->m_solver);
+        this->retune();
+    }
+
+    template<class TType, class TFunction>
+    TType AdaptiveSegmentSolver<TType, TFunction>::valueOnSegment(std::size_t t_left_index,
+                                                                  std::size_t t_right_index) const {
+        return std::visit([&](const auto &t_solver) {
+            return t_solver.valueOnSegment(t_left_index, t_right_index);
+        }, this->m_solver);
+    }
+
+    template<class TType, class TFunction>
+    TType AdaptiveSegmentSolver<TType, TFunction>::valueOnSegment(std::size_t t_left_index,
+                                                                  std::size_t t_right_index) {
+        ++this->m_queries;
+        this->m_total_length += static_cast<double>(t_right_index - t_left_index + 1);
+        auto result = std::as_const(*this).valueOnSegment(t_left_index, t_right_index);
+        this->retune();
+        return result;
+    }
+
+    template<class TType, class TFunction>
+    void AdaptiveSegmentSolver<TType, TFunction>::valueOnSegments(
+            const std::vector<std::pair<std::size_t, std::size_t>> &t_queries, std::vector<TType> &t_result) const {
+        std::visit([&](const auto &t_solver) {
+            t_solver.valueOnSegments(t_queries, t_result);
+        }, this->m_solver);
+    }
+
+    template<class TType, class TFunction>
+    void AdaptiveSegmentSolver<TType, TFunction>::valueOnSegments(
+            const std::vector<std::pair<std::size_t, std::size_t>> &t_queries, std::vector<TType> &t_result) {
+        this->m_queries += t_queries.size();
+        for (auto &[l, r] : t_queries) {
+            this->m_total_length += static_cast<double>(r - l + 1);
+        }
+        std::as_const(*this).valueOnSegments(t_queries, t_result);
+        this->retune();
+    }
+
+}
+
+#endif //COMPETITIVE_ALGORITHMS_ADAPTIVESEGMENTSOLVER_H
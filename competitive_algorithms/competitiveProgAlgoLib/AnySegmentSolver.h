@@ -0,0 +1,113 @@
+#ifndef COMPETITIVE_ALGORITHMS_ANYSEGMENTSOLVER_H
+#define COMPETITIVE_ALGORITHMS_ANYSEGMENTSOLVER_H
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace cpa {
+
+    template<class TType>
+    class AnySegmentSolver {
+    private:
+        struct concept_type {
+            virtual ~concept_type() = default;
+
+            [[nodiscard]] virtual std::unique_ptr<concept_type> clone() const = 0;
+
+            [[nodiscard]] virtual std::size_t size() const noexcept = 0;
+
+            virtual TType valueOnSegment(std::size_t t_left_index, std::size_t t_right_index) const = 0;
+
+            virtual void valueOnSegments(const std::vector<std::pair<std::size_t, std::size_t>> &t_queries,
+                                         std::vector<TType> &t_result) const = 0;
+        };
+
+        template<class TSolver>
+        struct model_type : concept_type {
+            TSolver solver;
+
+            explicit model_type(TSolver t_solver) : solver(std::move(t_solver)) {}
+
+            [[nodiscard]] std::unique_ptr<concept_type> clone() const override {
+                return std::make_unique<model_type<TSolver>>(this->solver);
+            }
+
+            [[nodiscard]] std::size_t size() const noexcept override {
+                return this->solver.size();
+            }
+
+            TType valueOnSegment(std::size_t t_left_index, std::size_t t_right_index) const override {
+                return this->solver.valueOnSegment(t_left_index, t_right_index);
+            }
+
+            void valueOnSegments(const std::vector<std::pair<std::size_t, std::size_t>> &t_queries,
+                                 std::vector<TType> &t_result) const override {
+                this->solver.valueOnSegments(t_queries, t_result);
+            }
+        };
+
+        std::unique_ptr<concept_type> m_solver;
+
+    public:
+        AnySegmentSolver() = default;
+
+        template<class TSolver, class = std::enable_if_t<!std::is_same_v<std::decay_t<TSolver>, AnySegmentSolver>>>
+        AnySegmentSolver(TSolver &&t_solver);
+
+        AnySegmentSolver(const AnySegmentSolver<TType> &other);
+
+        AnySegmentSolver(AnySegmentSolver<TType> &&other) noexcept = default;
+
+        AnySegmentSolver<TType> &operator=(AnySegmentSolver<TType> other) noexcept;
+
+        [[nodiscard]] bool empty() const noexcept;
+
+        [[nodiscard]] std::size_t size() const noexcept;
+
+        TType valueOnSegment(std::size_t t_left_index, std::size_t t_right_index) const;
+
+        void valueOnSegments(const std::vector<std::pair<std::size_t, std::size_t>> &t_queries,
+                             std::vector<TType> &t_result) const;
+    };
+
+    template<class TType>
+    template<class TSolver, class>
+    AnySegmentSolver<TType>::AnySegmentSolver(TSolver &&t_solver) :
+            m_solver(std::make_unique<model_type<std::decay_t<TSolver>>>(std::forward<TSolver>(t_solver))) {}
+
+    template<class TType>
+    AnySegmentSolver<TType>::AnySegmentSolver(const AnySegmentSolver<TType> &other) :
+            m_solver(other.m_solver ? other.m_solver->clone() : nullptr) {}
+
+    template<class TType>
+    AnySegmentSolver<TType> &AnySegmentSolver<TType>::operator=(AnySegmentSolver<TType> other) noexcept {
+        this->m_solver = std::move(other.m_solver);
+        return *this;
+    }
+
+    template<class TType>
+    bool AnySegmentSolver<TType>::empty() const noexcept {
+        return this->m_solver == nullptr;
+    }
+
+    template<class TType>
+    std::size_t AnySegmentSolver<TType>::size() const noexcept {
+        return this->m_solver ? this->m_solver->size() : 0;
+    }
+
+    template<class TType>
+    TType AnySegmentSolver<TType>::valueOnSegment(std::size_t t_left_index, std::size_t t_right_index) const {
+        return this->m_solver->valueOnSegment(t_left_index, t_right_index);
+    }
+
+    template<class TType>
+    void AnySegmentSolver<TType>::valueOnSegments(const std::vector<std::pair<std::size_t, std::size_t>> &t_queries,
+                                                  std::vector<TType> &t_result) const {
+        this->m_solver->valueOnSegments(t_queries, t_result);
+    }
+
+}
+
+#endif //COMPETITIVE_ALGORITHMS_ANYSEGMENTSOLVER_H
@@ -0,0 +1,121 @@
+#ifndef COMPETITIVE_ALGORITHMS_ARENA_H
+#define COMPETITIVE_ALGORITHMS_ARENA_H
+
+#include <array>
+#include <memory>
+#include <utility>
+#include "Intrinsics.h"
+
+namespace cpa {
+
+    template<class TType>
+    class Arena {
+    private:
+        static constexpr std::size_t first_chunk_size = 64;
+        static constexpr std::size_t chunk_count = 32;
+
+        std::array<std::unique_ptr<TType[]>, chunk_count> m_chunks;
+        std::size_t m_size = 0;
+
+        static std::size_t chunkOf(std::size_t t_index) noexcept;
+
+        static std::size_t chunkBegin(std::size_t t_chunk) noexcept;
+
+    public:
+        Arena() = default;
+
+        Arena(const Arena<TType> &other);
+
+        Arena(Arena<TType> &&other) noexcept;
+
+        Arena<TType> &operator=(const Arena<TType> &other);
+
+        Arena<TType> &operator=(Arena<TType> &&other) noexcept;
+
+        [[nodiscard]] std::size_t size() const noexcept;
+
+        TType &operator[](std::size_t t_index) noexcept;
+
+        const TType &operator[](std::size_t t_index) const noexcept;
+
+        void push_back(const TType &t_value);
+
+        void truncate(std::size_t t_size);
+    };
+
+    template<class TType>
+    std::size_t Arena<TType>::chunkOf(std::size_t t_index) noexcept {
+        return bitWidth(t_index / first_chunk_size + 1) - 1;
+    }
+
+    template<class TType>
+    std::size_t Arena<TType>::chunkBegin(std::size_t t_chunk) noexcept {
+        return first_chunk_size * ((std::size_t{1} << t_chunk) - 1);
+    }
+
+    template<class TType>
+    Arena<TType>::Arena(const Arena<TType> &other) {
+        for (std::size_t i = 0; i < other.m_size; ++i) {
+            this->push_back(other[i]);
+        }
+    }
+
+    template<class TType>
+    Arena<TType>::Arena(Arena<TType> &&other) noexcept {
+        this->m_chunks = std::move(other.m_chunks);
+        this->m_size = std::exchange(other.m_size, 0);
+    }
+
+    template<class TType>
+    Arena<TType> &Arena<TType>::operator=(const Arena<TType> &other) {
+        if (this != &other) {
+            *this = Arena<TType>(other);
+        }
+        return *this;
+    }
+
+    template<class TType>
+    Arena<TType> &Arena<TType>::operator=(Arena<TType> &&other) noexcept {
+        this->m_chunks = std::move(other.m_chunks);
+        this->m_size = std::exchange(other.m_size, 0);
+        return *this;
+    }
+
+    template<class TType>
+    std::size_t Arena<TType>::size() const noexcept {
+        return this->m_size;
+    }
+
+    template<class TType>
+    TType &Arena<TType>::operator[](std::size_t t_index) noexcept {
+        auto chunk = chunkOf(t_index);
+        return this->m_chunks[chunk][t_index - chunkBegin(chunk)];
+    }
+
+    template<class TType>
+    const TType &Arena<TType>::operator[](std::size_t t_index) const noexcept {
+        auto chunk = chunkOf(t_index);
+        return this->m_chunks[chunk][t_index - chunkBegin(chunk)];
+    }
+
+    template<class TType>
+    void Arena<TType>::push_back(const TType &t_value) {
+        auto chunk = chunkOf(this->m_size);
+        if (!this->m_chunks[chunk]) {
+            this->m_chunks[chunk] = std::make_unique<TType[]>(first_chunk_size << chunk);
+        }
+        this->m_chunks[chunk][this->m_size - chunkBegin(chunk)] = t_value;
+        ++this->m_size;
+    }
+
+    template<class TType>
+    void Arena<TType>::truncate(std::size_t t_size) {
+        this->m_size = t_size;
+        for (auto chunk = t_size == 0 ? 0 : chunkOf(t_size - 1) + 1; chunk < chunk_count; ++chunk) {
+            this->m_chunks[chunk].reset();
+        }
+    }
+
+}
+
+#endif //COMPETITIVE_ALGORITHMS_ARENA_H
@@ -5,31 +5,32 @@
 #include <vector>
 #include "IMutableDataStructure.h"
 #include "ISegmentSolver.h"
+#include "Reduce.h"
 
 namespace cpa {
 
     template<class TType, class TFunction = std::function<TType(const TType &, const TType &)>>
 
     class Array :
-            public IMutableDataStructure<TType>,
-            public ISegmentSolver<TType, TFunction> {
+            public IMutableDataStructure<Array<TType, TFunction>, TType>,
+            public ISegmentSolver<Array<TType, TFunction>, TType, TFunction> {
     private:
         std::vector<TType> m_data{};
     public:
-        explicit Array(const TFunction &t_function = nullptr);
+        explicit Array(const TFunction &t_function = TFunction());
 
         template<class TIter>
-        Array(TIter t_begin, TIter t_end, const TFunction &t_function = nullptr);
+        Array(TIter t_begin, TIter t_end, const TFunction &t_function = TFunction());
 
         Array(const Array<TType, TFunction> &other);
 
         Array(Array<TType, TFunction> &&other) noexcept;
 
-        const TType &getValueAt(std::size_t t_index) const override;
+        const TType &getValueAt(std::size_t t_index) const;
 
-        void changeValueAt(std::size_t t_index, const TType &t_value) override;
+        void changeValueAt(std::size_t t_index, const TType &t_value);
 
-        TType valueOnSegment(std::size_t t_left_index, std::size_t t_right_index) const override;
+        TType valueOnSegment(std::size_t t_left_index, std::size_t t_right_index) const;
     };
 
     template<class TType, class TFunction>
@@ -43,6 +44,7 @@ namespace cpa {
         this->m_function = t_function;
         m_data.assign(t_begin, t_end);
         this->m_size = m_data.size();
+        countRebuild(this->m_function, this->m_data);
     }
 
     template<class TType, class TFunction>
@@ -71,11 +73,8 @@ namespace cpa {
 
     template<class TType, class TFunction>
     TType Array<TType, TFunction>::valueOnSegment(std::size_t t_left_index, std::size_t t_right_index) const {
-        TType result = this->m_data[t_left_index];
-        for (std::size_t i = t_left_index + 1; i <= t_right_index; ++i) {
-            result = this->m_function(result, this->m_data[i]);
-        }
-        return result;
+        auto data = this->m_data.data();
+        return reduceSegment(data + t_left_index + 1, data + t_right_index + 1, data[t_left_index], this->m_function);
     }
 
 }
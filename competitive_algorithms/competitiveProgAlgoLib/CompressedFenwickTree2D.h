@@ -0,0 +1,169 @@
+#ifndef COMPETITIVE_ALGORITHMS_COMPRESSEDFENWICKTREE2D_H
+#define COMPETITIVE_ALGORITHMS_COMPRESSEDFENWICKTREE2D_H
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "IRectangleSolver.h"
+
+namespace cpa {
+
+    template<class TType, class TCoordinate = long long, class TGroup = Sum<TType>>
+    class CompressedFenwickTree2D :
+            public IRectangleSolver<CompressedFenwickTree2D<TType, TCoordinate, TGroup>, TType, TGroup, TCoordinate> {
+        static_assert(MonoidTraits<TGroup>::invertible && MonoidTraits<TGroup>::commutative,
+                      "CompressedFenwickTree2D requires a commutative invertible operation");
+
+    private:
+        std::vector<TCoordinate> m_xs;
+        std::vector<std::size_t> m_offsets;
+        std::vector<TCoordinate> m_ys;
+        std::vector<TType> m_tree;
+
+        template<class TIter>
+        void build(TIter t_begin, TIter t_end);
+
+        TType prefixValue(std::size_t t_x_count, const TCoordinate &t_first_y, const TCoordinate &t_last_y) const;
+
+    public:
+        explicit CompressedFenwickTree2D(const TGroup &t_function = TGroup());
+
+        template<class TIter>
+        CompressedFenwickTree2D(TIter t_begin, TIter t_end, const TGroup &t_function = TGroup());
+
+        CompressedFenwickTree2D(const CompressedFenwickTree2D<TType, TCoordinate, TGroup> &other);
+
+        CompressedFenwickTree2D(CompressedFenwickTree2D<TType, TCoordinate, TGroup> &&other) noexcept;
+
+        void addValueAt(const TCoordinate &t_x, const TCoordinate &t_y, const TType &t_delta);
+
+        TType valueOnRectangle(TCoordinate t_first_x, TCoordinate t_first_y,
+                               TCoordinate t_last_x, TCoordinate t_last_y) const;
+    };
+
+    template<class TType, class TCoordinate, class TGroup>
+    CompressedFenwickTree2D<TType, TCoordinate, TGroup>::CompressedFenwickTree2D(const TGroup &t_function) {
+        this->m_function = t_function;
+        this->m_offsets.push_back(0);
+    }
+
+    template<class TType, class TCoordinate, class TGroup>
+    template<class TIter>
+    CompressedFenwickTree2D<TType, TCoordinate, TGroup>::CompressedFenwickTree2D(TIter t_begin, TIter t_end,
+                                                                                 const TGroup &t_function) {
+        this->m_function = t_function;
+        build(t_begin, t_end);
+    }
+
+    template<class TType, class TCoordinate, class TGroup>
+    CompressedFenwickTree2D<TType, TCoordinate, TGroup>::CompressedFenwickTree2D(
+            const CompressedFenwickTree2D<TType, TCoordinate, TGroup> &other) {
+        this->m_function = other.m_function;
+        this->m_xs = other.m_xs;
+        this->m_offsets = other.m_offsets;
+        this->m_ys = other.m_ys;
+        this->m_tree = other.m_tree;
+    }
+
+    template<class TType, class TCoordinate, class TGroup>
+    CompressedFenwickTree2D<TType, TCoordinate, TGroup>::CompressedFenwickTree2D(
+            CompressedFenwickTree2D<TType, TCoordinate, TGroup> &&other) noexcept {
+        this->m_function = std::move(other.m_function);
+        this->m_xs = std::move(other.m_xs);
+        this->m_offsets = std::move(other.m_offsets);
+        this->m_ys = std::move(other.m_ys);
+        this->m_tree = std::move(other.m_tree);
+    }
+
+    template<class TType, class TCoordinate, class TGroup>
+    template<class TIter>
+    void CompressedFenwickTree2D<TType, TCoordinate, TGroup>::build(TIter t_begin, TIter t_end) {
+        std::vector<std::pair<TCoordinate, TCoordinate>> points(t_begin, t_end);
+        std::sort(points.begin(), points.end(), [](const auto &a, const auto &b) {
+            return a.second < b.second || (!(b.second < a.second) && a.first < b.first);
+        });
+        for (auto &point : points) {
+            this->m_xs.push_back(point.first);
+        }
+        std::sort(this->m_xs.begin(), this->m_xs.end());
+        this->m_xs.erase(std::unique(this->m_xs.begin(), this->m_xs.end()), this->m_xs.end());
+        std::vector<std::vector<TCoordinate>> columns(this->m_xs.size() + 1);
+        for (auto &point : points) {
+            auto i = std::lower_bound(this->m_xs.begin(), this->m_xs.end(), point.first) - this->m_xs.begin() + 1;
+            for (auto x = static_cast<std::size_t>(i); x <= this->m_xs.size(); x += x & (~x + 1)) {
+                if (columns[x].empty() || columns[x].back() < point.second) {
+                    columns[x].push_back(point.second);
+                }
+            }
+        }
+        this->m_offsets.assign(1, 0);
+        for (std::size_t x = 1; x <= this->m_xs.size(); ++x) {
+            this->m_ys.insert(this->m_ys.end(), columns[x].begin(), columns[x].end());
+            this->m_offsets.push_back(this->m_ys.size());
+        }
+        this->m_tree.assign(this->m_ys.size(), TGroup::identity());
+    }
+
+    template<class TType, class TCoordinate, class TGroup>
+    void CompressedFenwickTree2D<TType, TCoordinate, TGroup>::addValueAt(const TCoordinate &t_x,
+                                                                         const TCoordinate &t_y,
+                                                                         const TType &t_delta) {
+        auto i = std::lower_bound(this->m_xs.begin(), this->m_xs.end(), t_x) - this->m_xs.begin() + 1;
+        if (static_cast<std::size_t>(i) > this->m_xs.size() || t_x < this->m_xs[i - 1]) {
+            throw std::out_of_range("point was not registered at construction");
+        }
+        // Fenwick columns along the update path nest, so a y present in the first one is present in all of them.
+        auto first_ys = this->m_ys.begin() + this->m_offsets[i - 1];
+        auto first_ys_end = this->m_ys.begin() + this->m_offsets[i];
+        auto first_y = std::lower_bound(first_ys, first_ys_end, t_y);
+        if (first_y == first_ys_end || t_y < *first_y) {
+            throw std::out_of_range("point was not registered at construction");
+        }
+        for (auto x = static_cast<std::size_t>(i); x <= this->m_xs.size(); x += x & (~x + 1)) {
+            auto ys = this->m_ys.begin() + this->m_offsets[x - 1];
+            auto count = this->m_offsets[x] - this->m_offsets[x - 1];
+            auto tree = this->m_tree.begin() + this->m_offsets[x - 1];
+            auto j = std::lower_bound(ys, ys + count, t_y) - ys + 1;
+            for (auto y = static_cast<std::size_t>(j); y <= count; y += y & (~y + 1)) {
+                tree[y - 1] = this->m_function(tree[y - 1], t_delta);
+            }
+        }
+    }
+
+    template<class TType, class TCoordinate, class TGroup>
+    TType CompressedFenwickTree2D<TType, TCoordinate, TGroup>::prefixValue(std::size_t t_x_count,
+                                                                           const TCoordinate &t_first_y,
+                                                                           const TCoordinate &t_last_y) const {
+        auto included = TGroup::identity();
+        auto excluded = TGroup::identity();
+        for (auto x = t_x_count; x > 0; x &= x - 1) {
+            auto ys = this->m_ys.begin() + this->m_offsets[x - 1];
+            auto count = this->m_offsets[x] - this->m_offsets[x - 1];
+            auto tree = this->m_tree.begin() + this->m_offsets[x - 1];
+            for (auto y = static_cast<std::size_t>(std::upper_bound(ys, ys + count, t_last_y) - ys); y > 0;
+                 y &= y - 1) {
+                included = this->m_function(included, tree[y - 1]);
+            }
+            for (auto y = static_cast<std::size_t>(std::lower_bound(ys, ys + count, t_first_y) - ys); y > 0;
+                 y &= y - 1) {
+                excluded = this->m_function(excluded, tree[y - 1]);
+            }
+        }
+        return this->m_function(included, TGroup::inverse(excluded));
+    }
+
+    template<class TType, class TCoordinate, class TGroup>
+    TType CompressedFenwickTree2D<TType, TCoordinate, TGroup>::valueOnRectangle(TCoordinate t_first_x,
+                                                                                TCoordinate t_first_y,
+                                                                                TCoordinate t_last_x,
+                                                                                TCoordinate t_last_y) const {
+        auto last = std::upper_bound(this->m_xs.begin(), this->m_xs.end(), t_last_x) - this->m_xs.begin();
+        auto first = std::lower_bound(this->m_xs.begin(), this->m_xs.end(), t_first_x) - this->m_xs.begin();
+        return this->m_function(prefixValue(last, t_first_y, t_last_y),
+                                TGroup::inverse(prefixValue(first, t_first_y, t_last_y)));
+    }
+
+}
+
+#endif //COMPETITIVE_ALGORITHMS_COMPRESSEDFENWICKTREE2D_H
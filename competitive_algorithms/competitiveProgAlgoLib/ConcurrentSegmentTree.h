@@ -0,0 +1,196 @@
+#ifndef COMPETITIVE_ALGORITHMS_CONCURRENTSEGMENTTREE_H
+#define COMPETITIVE_ALGORITHMS_CONCURRENTSEGMENTTREE_H
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include "ISegmentSolver.h"
+#include "Intrinsics.h"
+#include "Parallel.h"
+
+namespace cpa {
+
+    // Single writer, many readers. A read retries while a write overlaps it, so it completes as soon as one
+    // O(log n) query runs without a concurrent changeValueAt; a writer that never pauses can starve readers.
+    template<class TType, class TFunction = std::function<TType(const TType &, const TType &)>>
+    class ConcurrentSegmentTree :
+            public ISegmentSolver<ConcurrentSegmentTree<TType, TFunction>, TType, TFunction> {
+        static_assert(std::is_trivially_copyable_v<TType>,
+                      "ConcurrentSegmentTree requires a trivially copyable value type");
+    private:
+        static constexpr std::size_t cache_line_size = 64;
+        static constexpr std::size_t max_spin_count = 64;
+
+        std::size_t m_size{};
+        std::unique_ptr<std::atomic<TType>[]> m_nodes;
+        alignas(cache_line_size) std::atomic<std::size_t> m_sequence{0};
+
+        TType node(std::size_t t_index) const noexcept;
+
+        TType query(std::size_t t_left_index, std::size_t t_right_index) const;
+
+        static void backoff(std::size_t &t_spin_count) noexcept;
+
+    public:
+        explicit ConcurrentSegmentTree(const TFunction &t_function = TFunction());
+
+        template<class TIter>
+        ConcurrentSegmentTree(TIter t_begin, TIter t_end, const TFunction &t_function = TFunction(),
+                              std::size_t t_thread_count = 1);
+
+        ConcurrentSegmentTree(const ConcurrentSegmentTree<TType, TFunction> &other);
+
+        ConcurrentSegmentTree(ConcurrentSegmentTree<TType, TFunction> &&other) noexcept;
+
+        [[nodiscard]] std::size_t size() const noexcept;
+
+        TType getValueAt(std::size_t t_index) const;
+
+        void changeValueAt(std::size_t t_index, const TType &t_value);
+
+        TType valueOnSegment(std::size_t t_left_index, std::size_t t_right_index) const;
+    };
+
+    template<class TType, class TFunction>
+    ConcurrentSegmentTree<TType, TFunction>::ConcurrentSegmentTree(const TFunction &t_function) {
+        this->m_function = t_function;
+    }
+
+    template<class TType, class TFunction>
+    template<class TIter>
+    ConcurrentSegmentTree<TType, TFunction>::ConcurrentSegmentTree(TIter t_begin, TIter t_end,
+                                                                   const TFunction &t_function,
+                                                                   std::size_t t_thread_count) {
+        this->m_function = t_function;
+        this->m_size = std::distance(t_begin, t_end);
+        if (this->m_size == 0) {
+            return;
+        }
+        this->m_nodes.reset(new std::atomic<TType>[this->m_size * 2]);
+        std::size_t i = this->m_size;
+        for (auto it = t_begin; it != t_end; ++it, ++i) {
+            this->m_nodes[i].store(*it, std::memory_order_relaxed);
+        }
+        auto thread_count = resolveThreadCount(t_thread_count);
+        for (auto level = bitWidth(this->m_size - 1); level > 0; --level) {
+            auto level_begin = std::size_t{1} << (level - 1);
+            auto level_end = std::min(level_begin << 1u, this->m_size);
+            parallelFor(level_begin, level_end, thread_count, [this](std::size_t j) {
+                this->m_nodes[j].store(this->m_function(node(j << 1u), node((j << 1u) | 1u)),
+                                       std::memory_order_relaxed);
+            });
+        }
+        std::atomic_thread_fence(std::memory_order_release);
+    }
+
+    template<class TType, class TFunction>
+    ConcurrentSegmentTree<TType, TFunction>::ConcurrentSegmentTree(
+            const ConcurrentSegmentTree<TType, TFunction> &other) {
+        this->m_function = other.m_function;
+        this->m_size = other.m_size;
+        if (this->m_size == 0) {
+            return;
+        }
+        this->m_nodes.reset(new std::atomic<TType>[this->m_size * 2]);
+        for (std::size_t i = 1; i < this->m_size * 2; ++i) {
+            this->m_nodes[i].store(other.node(i), std::memory_order_relaxed);
+        }
+    }
+
+    template<class TType, class TFunction>
+    ConcurrentSegmentTree<TType, TFunction>::ConcurrentSegmentTree(
+            ConcurrentSegmentTree<TType, TFunction> &&other) noexcept {
+        this->m_function = std::move(other.m_function);
+        this->m_size = std::move(other.m_size);
+        this->m_nodes = std::move(other.m_nodes);
+    }
+
+    template<class TType, class TFunction>
+    std::size_t ConcurrentSegmentTree<TType, TFunction>::size() const noexcept {
+        return this->m_size;
+    }
+
+    template<class TType, class TFunction>
+    TType ConcurrentSegmentTree<TType, TFunction>::node(std::size_t t_index) const noexcept {
+        return this->m_nodes[t_index].load(std::memory_order_relaxed);
+    }
+
+    template<class TType, class TFunction>
+    TType ConcurrentSegmentTree<TType, TFunction>::getValueAt(std::size_t t_index) const {
+        return this->m_nodes[this->m_size + t_index].load(std::memory_order_acquire);
+    }
+
+    template<class TType, class TFunction>
+    void ConcurrentSegmentTree<TType, TFunction>::changeValueAt(std::size_t t_index, const TType &t_value) {
+        auto sequence = this->m_sequence.load(std::memory_order_relaxed);
+        this->m_sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        t_index += this->m_size;
+        for (this->m_nodes[t_index].store(t_value, std::memory_order_relaxed); t_index > 1; t_index >>= 1u) {
+            this->m_nodes[t_index >> 1u].store(this->m_function(node(t_index), node(t_index ^ 1u)),
+                                               std::memory_order_relaxed);
+        }
+        this->m_sequence.store(sequence + 2, std::memory_order_release);
+    }
+
+    template<class TType, class TFunction>
+    TType ConcurrentSegmentTree<TType, TFunction>::query(std::size_t t_left_index, std::size_t t_right_index) const {
+        t_left_index += this->m_size;
+        t_right_index += this->m_size + 1;
+        while ((t_left_index & 1u) == 0 && (t_right_index & 1u) == 0) {
+            t_left_index >>= 1u;
+            t_right_index >>= 1u;
+        }
+        auto odd_left = (t_left_index & 1u) == 1;
+        auto odd_right = (t_right_index & 1u) == 1;
+        auto result = odd_left ? node(t_left_index++) : node(--t_right_index);
+        if (odd_left && odd_right) {
+            result = this->m_function(result, node(--t_right_index));
+        }
+        t_left_index >>= 1u;
+        t_right_index >>= 1u;
+        while (t_left_index < t_right_index) {
+            if ((t_left_index & 1u) == 1) {
+                result = this->m_function(result, node(t_left_index++));
+            }
+            if ((t_right_index & 1u) == 1) {
+                result = this->m_function(result, node(--t_right_index));
+            }
+            t_left_index >>= 1u;
+            t_right_index >>= 1u;
+        }
+        return result;
+    }
+
+    template<class TType, class TFunction>
+    void ConcurrentSegmentTree<TType, TFunction>::backoff(std::size_t &t_spin_count) noexcept {
+        if (t_spin_count < max_spin_count) {
+            for (std::size_t i = 0; i <= t_spin_count; ++i) {
+                cpuRelax();
+            }
+            t_spin_count = t_spin_count * 2 + 1;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    template<class TType, class TFunction>
+    TType ConcurrentSegmentTree<TType, TFunction>::valueOnSegment(std::size_t t_left_index,
+                                                                  std::size_t t_right_index) const {
+        for (std::size_t spin_count = 0;; backoff(spin_count)) {
+            auto sequence = this->m_sequence.load(std::memory_order_acquire);
+            if ((sequence & 1u) == 1) {
+                continue;
+            }
+            auto result = query(t_left_index, t_right_index);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (this->m_sequence.load(std::memory_order_relaxed) == sequence) {
+                return result;
+            }
+        }
+    }
+
+}
+
+#endif //COMPETITIVE_ALGORITHMS_CONCURRENTSEGMENTTREE_H
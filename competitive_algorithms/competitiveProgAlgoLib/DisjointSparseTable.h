@@ -0,0 +1,115 @@
+#ifndef COMPETITIVE_ALGORITHMS_DISJOINTSPARSETABLE_H
+#define COMPETITIVE_ALGORITHMS_DISJOINTSPARSETABLE_H
+
+#include <algorithm>
+#include <vector>
+#include "ISegmentSolver.h"
+#include "IDataStructure.h"
+#include "Intrinsics.h"
+
+namespace cpa {
+
+    template<class TType, class TFunction = std::function<TType(const TType &, const TType &)>>
+    class DisjointSparseTable :
+            public IDataStructure<DisjointSparseTable<TType, TFunction>, TType>,
+            public ISegmentSolver<DisjointSparseTable<TType, TFunction>, TType, TFunction> {
+    private:
+        std::size_t m_levels{};
+        std::vector<TType> m_table;
+
+        template<class TIter>
+        void build(TIter t_begin, TIter t_end);
+
+    public:
+        explicit DisjointSparseTable(const TFunction &t_function = TFunction());
+
+        template<class TIter>
+        DisjointSparseTable(TIter t_begin, TIter t_end, const TFunction &t_function = TFunction());
+
+        DisjointSparseTable(const DisjointSparseTable<TType, TFunction> &other);
+
+        DisjointSparseTable(DisjointSparseTable<TType, TFunction> &&other) noexcept;
+
+        const TType &getValueAt(std::size_t t_index) const;
+
+        TType valueOnSegment(std::size_t t_left_index, std::size_t t_right_index) const;
+    };
+
+    template<class TType, class TFunction>
+    DisjointSparseTable<TType, TFunction>::DisjointSparseTable(const TFunction &t_function) {
+        this->m_function = t_function;
+    }
+
+    template<class TType, class TFunction>
+    template<class TIter>
+    DisjointSparseTable<TType, TFunction>::DisjointSparseTable(TIter t_begin, TIter t_end,
+                                                               const TFunction &t_function) {
+        this->m_function = t_function;
+        build(t_begin, t_end);
+    }
+
+    template<class TType, class TFunction>
+    DisjointSparseTable<TType, TFunction>::DisjointSparseTable(const DisjointSparseTable<TType, TFunction> &other) {
+        this->m_function = other.m_function;
+        this->m_size = other.m_size;
+        this->m_levels = other.m_levels;
+        this->m_table = other.m_table;
+    }
+
+    template<class TType, class TFunction>
+    DisjointSparseTable<TType, TFunction>::DisjointSparseTable(
+            DisjointSparseTable<TType, TFunction> &&other) noexcept {
+        this->m_function = std::move(other.m_function);
+        this->m_size = std::move(other.m_size);
+        this->m_levels = std::move(other.m_levels);
+        this->m_table = std::move(other.m_table);
+    }
+
+    template<class TType, class TFunction>
+    template<class TIter>
+    void DisjointSparseTable<TType, TFunction>::build(TIter t_begin, TIter t_end) {
+        this->m_table.assign(t_begin, t_end);
+        this->m_size = this->m_table.size();
+        if (this->m_size == 0) {
+            return;
+        }
+        this->m_levels = bitWidth(this->m_size - 1);
+        this->m_table.resize(this->m_size * (this->m_levels + 1));
+        countRebuild(this->m_function, this->m_table);
+        auto data = this->m_table.begin();
+        for (std::size_t h = 0; h < this->m_levels; ++h) {
+            auto level = this->m_table.begin() + (h + 1) * this->m_size;
+            auto half = std::size_t{1} << h;
+            for (std::size_t block = 0; block + half < this->m_size; block += half << 1u) {
+                auto middle = block + half;
+                auto block_end = std::min(middle + half, this->m_size);
+                level[middle - 1] = data[middle - 1];
+                for (auto i = middle - 1; i > block; --i) {
+                    level[i - 1] = this->m_function(data[i - 1], level[i]);
+                }
+                level[middle] = data[middle];
+                for (auto i = middle + 1; i < block_end; ++i) {
+                    level[i] = this->m_function(level[i - 1], data[i]);
+                }
+            }
+        }
+    }
+
+    template<class TType, class TFunction>
+    const TType &DisjointSparseTable<TType, TFunction>::getValueAt(std::size_t t_index) const {
+        return this->m_table[t_index];
+    }
+
+    template<class TType, class TFunction>
+    TType DisjointSparseTable<TType, TFunction>::valueOnSegment(std::size_t t_left_index,
+                                                                std::size_t t_right_index) const {
+        if (t_left_index == t_right_index) {
+            return this->m_table[t_left_index];
+        }
+        auto offset = bitWidth(t_left_index ^ t_right_index) * this->m_size;
+        return this->m_function(this->m_table[offset + t_left_index], this->m_table[offset + t_right_index]);
+    }
+
+}
+
+#endif //COMPETITIVE_ALGORITHMS_DISJOINTSPARSETABLE_H
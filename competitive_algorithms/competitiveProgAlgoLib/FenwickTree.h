@@ -3,35 +3,47 @@
 
 #include "IMutableDataStructure.h"
 #include "ISegmentSolver.h"
+#include "Intrinsics.h"
+#include "Parallel.h"
 
 namespace cpa {
 
     template<class TType, class TFunction = std::function<TType(const TType &, const TType &)>>
     class FenwickTree :
-            public IMutableDataStructure<TType>,
-            public ISegmentSolver<TType, TFunction> {
+            public IMutableDataStructure<FenwickTree<TType, TFunction>, TType>,
+            public ISegmentSolver<FenwickTree<TType, TFunction>, TType, TFunction> {
     private:
         std::vector<TType> m_tree;
         std::vector<TType> m_counter_tree;
 
         template<class TIter>
-        void build(TIter t_begin, TIter t_end);
+        void build(TIter t_begin, TIter t_end, std::size_t t_thread_count);
 
         [[nodiscard]] int f(unsigned int x) const noexcept;
 
         [[nodiscard]] int g(unsigned int x) const noexcept;
 
     public:
-        const TType &getValueAt(std::size_t t_index) const override;
+        const TType &getValueAt(std::size_t t_index) const;
 
-        void changeValueAt(std::size_t t_index, const TType &t_value) override;
+        void changeValueAt(std::size_t t_index, const TType &t_value);
 
-        TType valueOnSegment(std::size_t t_left_index, std::size_t t_right_index) const override;
+        TType valueOnSegment(std::size_t t_left_index, std::size_t t_right_index) const;
 
-        explicit FenwickTree(const TFunction &t_function = nullptr);
+        void valueOnSegments(const std::vector<std::pair<std::size_t, std::size_t>> &t_queries,
+                             std::vector<TType> &t_result) const;
+
+        template<class TPredicate>
+        std::size_t maxRight(std::size_t t_left_index, const TPredicate &t_predicate) const;
+
+        template<class TPredicate>
+        std::size_t minLeft(std::size_t t_right_index, const TPredicate &t_predicate) const;
+
+        explicit FenwickTree(const TFunction &t_function = TFunction());
 
         template<class TIter>
-        FenwickTree(TIter t_begin, TIter t_end, const TFunction &t_function = nullptr);
+        FenwickTree(TIter t_begin, TIter t_end, const TFunction &t_function = TFunction(),
+                    std::size_t t_thread_count = 1);
 
         FenwickTree(const FenwickTree<TType, TFunction> &other);
 
@@ -46,9 +58,10 @@ namespace cpa {
 
     template<class TType, class TFunction>
     template<class TIter>
-    FenwickTree<TType, TFunction>::FenwickTree(TIter t_begin, TIter t_end, const TFunction &t_function) {
+    FenwickTree<TType, TFunction>::FenwickTree(TIter t_begin, TIter t_end, const TFunction &t_function,
+                                               std::size_t t_thread_count) {
         this->m_function = t_function;
-        build(t_begin, t_end);
+        build(t_begin, t_end, resolveThreadCount(t_thread_count));
     }
 
     template<class TType, class TFunction>
@@ -69,24 +82,31 @@ namespace cpa {
 
     template<class TType, class TFunction>
     template<class TIter>
-    void FenwickTree<TType, TFunction>::build(TIter t_begin, TIter t_end) {
+    void FenwickTree<TType, TFunction>::build(TIter t_begin, TIter t_end, std::size_t t_thread_count) {
         this->m_tree.assign(t_begin, t_end);
         this->m_counter_tree.assign(std::next(this->m_tree.begin()), this->m_tree.end());
         this->m_size = this->m_tree.size();
-        for (std::size_t i = 1; (1u << i) <= this->m_size; ++i) {
-            for (std::size_t j = (1u << i) - 1; j < this->m_size; j += 1u << (i + 1)) {
+        countRebuild(this->m_function, this->m_tree, this->m_counter_tree);
+        for (std::size_t i = 1; (std::size_t{1} << i) <= this->m_size; ++i) {
+            auto first = (std::size_t{1} << i) - 1;
+            auto step = std::size_t{1} << (i + 1);
+            parallelFor(0, (this->m_size - first + step - 1) / step, t_thread_count, [&](std::size_t t) {
+                auto j = first + t * step;
                 for (std::size_t k = 0; k < i; ++k) {
-                    this->m_tree[j] = this->m_function(this->m_tree[j], this->m_tree[j ^ (1u << k)]);
+                    this->m_tree[j] = this->m_function(this->m_tree[j], this->m_tree[j ^ (std::size_t{1} << k)]);
                 }
-            }
+            });
         }
-        for (std::size_t i = 1; (1u << i) < this->m_size; ++i) {
-            for (std::size_t j = (1u << i) - 1; j < this->m_size; j += 1u << (i + 1)) {
-                for (std::size_t k = 0; k < i && j + (1u << k) < this->m_counter_tree.size(); ++k) {
+        for (std::size_t i = 1; (std::size_t{1} << i) < this->m_size; ++i) {
+            auto first = (std::size_t{1} << i) - 1;
+            auto step = std::size_t{1} << (i + 1);
+            parallelFor(0, (this->m_size - first + step - 1) / step, t_thread_count, [&](std::size_t t) {
+                auto j = first + t * step;
+                for (std::size_t k = 0; k < i && j + (std::size_t{1} << k) < this->m_counter_tree.size(); ++k) {
                     this->m_counter_tree[j] = this->m_function(this->m_counter_tree[j],
-                                                               this->m_counter_tree[j + (1u << k)]);
+                                                               this->m_counter_tree[j + (std::size_t{1} << k)]);
                 }
-            }
+            });
         }
     }
 
@@ -128,6 +148,102 @@ namespace cpa {
         return res;
     }
 
+    template<class TType, class TFunction>
+    void FenwickTree<TType, TFunction>::valueOnSegments(
+            const std::vector<std::pair<std::size_t, std::size_t>> &t_queries, std::vector<TType> &t_result) const {
+        constexpr std::size_t batch_size = 8;
+        t_result.clear();
+        t_result.reserve(t_queries.size());
+        for (std::size_t begin = 0; begin < t_queries.size(); begin += batch_size) {
+            auto end = std::min(begin + batch_size, t_queries.size());
+            auto next_end = std::min(end + batch_size, t_queries.size());
+            for (auto q = end; q < next_end; ++q) {
+                int l = static_cast<int>(t_queries[q].first) - 1;
+                int r = t_queries[q].second;
+                prefetch(&this->m_tree[r]);
+                if (f(r) >= 0) {
+                    prefetch(&this->m_tree[f(r)]);
+                }
+                if (l >= 0) {
+                    prefetch(&this->m_counter_tree[l]);
+                    if (static_cast<std::size_t>(g(l)) < this->m_counter_tree.size()) {
+                        prefetch(&this->m_counter_tree[g(l)]);
+                    }
+                }
+            }
+            for (auto q = begin; q < end; ++q) {
+                t_result.push_back(this->valueOnSegment(t_queries[q].first, t_queries[q].second));
+            }
+        }
+    }
+
+    template<class TType, class TFunction>
+    template<class TPredicate>
+    std::size_t FenwickTree<TType, TFunction>::maxRight(std::size_t t_left_index,
+                                                        const TPredicate &t_predicate) const {
+        TType accumulated{};
+        bool has_accumulated = false;
+        auto accepts = [&](const TType &t_value) {
+            auto candidate = has_accumulated ? this->m_function(accumulated, t_value) : t_value;
+            if (!t_predicate(candidate)) {
+                return false;
+            }
+            accumulated = std::move(candidate);
+            has_accumulated = true;
+            return true;
+        };
+        if (t_left_index >= this->m_size) {
+            return this->m_size;
+        }
+        auto end = t_left_index;
+        std::size_t step = std::size_t{1} << (bitWidth(this->m_size) - 1);
+        if (end > 0) {
+            while (accepts(this->m_counter_tree[end - 1])) {
+                end = ((end - 1) | end) + 1;
+                if (end >= this->m_size) {
+                    return this->m_size;
+                }
+            }
+            step = (((end - 1) ^ end) + 1) >> 2u;
+        }
+        for (; step > 0; step >>= 1u) {
+            if (end + step <= this->m_size && accepts(this->m_tree[end + step - 1])) {
+                end += step;
+            }
+        }
+        return end;
+    }
+
+    template<class TType, class TFunction>
+    template<class TPredicate>
+    std::size_t FenwickTree<TType, TFunction>::minLeft(std::size_t t_right_index,
+                                                       const TPredicate &t_predicate) const {
+        TType accumulated{};
+        bool has_accumulated = false;
+        auto accepts = [&](const TType &t_value) {
+            auto candidate = has_accumulated ? this->m_function(t_value, accumulated) : t_value;
+            if (!t_predicate(candidate)) {
+                return false;
+            }
+            accumulated = std::move(candidate);
+            has_accumulated = true;
+            return true;
+        };
+        auto end = t_right_index + 1;
+        while (accepts(this->m_tree[end - 1])) {
+            end = (end - 1) & end;
+            if (end == 0) {
+                return 0;
+            }
+        }
+        for (auto step = (((end - 1) ^ end) + 1) >> 2u; step > 0; step >>= 1u) {
+            if (accepts(this->m_counter_tree[end - 1 - step])) {
+                end -= step;
+            }
+        }
+        return end;
+    }
+
     template<class TType, class TFunction>
     int FenwickTree<TType, TFunction>::f(unsigned int x) const noexcept {
         return static_cast<int>(x & (x + 1)) - 1;
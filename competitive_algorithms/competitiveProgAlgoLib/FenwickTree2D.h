@@ -0,0 +1,175 @@
+#ifndef COMPETITIVE_ALGORITHMS_FENWICKTREE2D_H
+#define COMPETITIVE_ALGORITHMS_FENWICKTREE2D_H
+
+#include <algorithm>
+#include <vector>
+#include "IMutableGridDataStructure.h"
+#include "IRectangleSolver.h"
+
+namespace cpa {
+
+    template<class TType, class TGroup = Sum<TType>>
+    class FenwickTree2D :
+            public IMutableGridDataStructure<FenwickTree2D<TType, TGroup>, TType>,
+            public IRectangleSolver<FenwickTree2D<TType, TGroup>, TType, TGroup> {
+        static_assert(MonoidTraits<TGroup>::invertible && MonoidTraits<TGroup>::commutative,
+                      "FenwickTree2D requires a commutative invertible operation");
+
+    private:
+        std::vector<TType> m_data;
+        std::vector<TType> m_tree;
+
+        template<class TIter>
+        void build(TIter t_begin, TIter t_end);
+
+        void propagate(std::size_t t_row, std::size_t t_column, const TType &t_delta);
+
+        TType prefixCount(std::size_t t_row_count, std::size_t t_column_count) const;
+
+    public:
+        explicit FenwickTree2D(const TGroup &t_function = TGroup());
+
+        template<class TIter>
+        FenwickTree2D(TIter t_begin, TIter t_end, std::size_t t_columns, const TGroup &t_function = TGroup());
+
+        FenwickTree2D(const FenwickTree2D<TType, TGroup> &other);
+
+        FenwickTree2D(FenwickTree2D<TType, TGroup> &&other) noexcept;
+
+        const TType &getValueAt(std::size_t t_row, std::size_t t_column) const;
+
+        void changeValueAt(std::size_t t_row, std::size_t t_column, const TType &t_value);
+
+        void addValueAt(std::size_t t_row, std::size_t t_column, const TType &t_delta);
+
+        TType prefix(std::size_t t_row, std::size_t t_column) const;
+
+        TType valueOnRectangle(std::size_t t_first_row, std::size_t t_first_column,
+                               std::size_t t_last_row, std::size_t t_last_column) const;
+    };
+
+    template<class TType, class TGroup>
+    FenwickTree2D<TType, TGroup>::FenwickTree2D(const TGroup &t_function) {
+        this->m_function = t_function;
+    }
+
+    template<class TType, class TGroup>
+    template<class TIter>
+    FenwickTree2D<TType, TGroup>::FenwickTree2D(TIter t_begin, TIter t_end, std::size_t t_columns,
+                                                const TGroup &t_function) {
+        this->m_function = t_function;
+        this->m_columns = t_columns;
+        build(t_begin, t_end);
+    }
+
+    template<class TType, class TGroup>
+    FenwickTree2D<TType, TGroup>::FenwickTree2D(const FenwickTree2D<TType, TGroup> &other) {
+        this->m_function = other.m_function;
+        this->m_rows = other.m_rows;
+        this->m_columns = other.m_columns;
+        this->m_data = other.m_data;
+        this->m_tree = other.m_tree;
+    }
+
+    template<class TType, class TGroup>
+    FenwickTree2D<TType, TGroup>::FenwickTree2D(FenwickTree2D<TType, TGroup> &&other) noexcept {
+        this->m_function = std::move(other.m_function);
+        this->m_rows = std::move(other.m_rows);
+        this->m_columns = std::move(other.m_columns);
+        this->m_data = std::move(other.m_data);
+        this->m_tree = std::move(other.m_tree);
+    }
+
+    template<class TType, class TGroup>
+    template<class TIter>
+    void FenwickTree2D<TType, TGroup>::build(TIter t_begin, TIter t_end) {
+        this->m_data.assign(t_begin, t_end);
+        this->m_rows = this->m_columns == 0 ? 0 : this->m_data.size() / this->m_columns;
+        auto width = this->m_columns + 1;
+        this->m_tree.assign((this->m_rows + 1) * width, TGroup::identity());
+        for (std::size_t i = 0; i < this->m_rows; ++i) {
+            std::copy(this->m_data.begin() + i * this->m_columns, this->m_data.begin() + (i + 1) * this->m_columns,
+                      this->m_tree.begin() + (i + 1) * width + 1);
+        }
+        for (std::size_t i = 1; i <= this->m_rows; ++i) {
+            auto row = this->m_tree.begin() + i * width;
+            for (std::size_t j = 1; j <= this->m_columns; ++j) {
+                auto parent = j + (j & (~j + 1));
+                if (parent <= this->m_columns) {
+                    row[parent] = this->m_function(row[parent], row[j]);
+                }
+            }
+        }
+        for (std::size_t i = 1; i <= this->m_rows; ++i) {
+            auto parent = i + (i & (~i + 1));
+            if (parent > this->m_rows) {
+                continue;
+            }
+            auto row = this->m_tree.begin() + i * width;
+            auto parent_row = this->m_tree.begin() + parent * width;
+            for (std::size_t j = 1; j <= this->m_columns; ++j) {
+                parent_row[j] = this->m_function(parent_row[j], row[j]);
+            }
+        }
+    }
+
+    template<class TType, class TGroup>
+    void FenwickTree2D<TType, TGroup>::propagate(std::size_t t_row, std::size_t t_column, const TType &t_delta) {
+        auto width = this->m_columns + 1;
+        for (auto i = t_row + 1; i <= this->m_rows; i += i & (~i + 1)) {
+            for (auto j = t_column + 1; j <= this->m_columns; j += j & (~j + 1)) {
+                this->m_tree[i * width + j] = this->m_function(this->m_tree[i * width + j], t_delta);
+            }
+        }
+    }
+
+    template<class TType, class TGroup>
+    TType FenwickTree2D<TType, TGroup>::prefixCount(std::size_t t_row_count, std::size_t t_column_count) const {
+        auto width = this->m_columns + 1;
+        auto result = TGroup::identity();
+        for (auto i = t_row_count; i > 0; i &= i - 1) {
+            for (auto j = t_column_count; j > 0; j &= j - 1) {
+                result = this->m_function(result, this->m_tree[i * width + j]);
+            }
+        }
+        return result;
+    }
+
+    template<class TType, class TGroup>
+    const TType &FenwickTree2D<TType, TGroup>::getValueAt(std::size_t t_row, std::size_t t_column) const {
+        return this->m_data[t_row * this->m_columns + t_column];
+    }
+
+    template<class TType, class TGroup>
+    void FenwickTree2D<TType, TGroup>::changeValueAt(std::size_t t_row, std::size_t t_column, const TType &t_value) {
+        auto &current = this->m_data[t_row * this->m_columns + t_column];
+        auto delta = this->m_function(t_value, TGroup::inverse(current));
+        current = t_value;
+        propagate(t_row, t_column, delta);
+    }
+
+    template<class TType, class TGroup>
+    void FenwickTree2D<TType, TGroup>::addValueAt(std::size_t t_row, std::size_t t_column, const TType &t_delta) {
+        auto &current = this->m_data[t_row * this->m_columns + t_column];
+        current = this->m_function(current, t_delta);
+        propagate(t_row, t_column, t_delta);
+    }
+
+    template<class TType, class TGroup>
+    TType FenwickTree2D<TType, TGroup>::prefix(std::size_t t_row, std::size_t t_column) const {
+        return prefixCount(t_row + 1, t_column + 1);
+    }
+
+    template<class TType, class TGroup>
+    TType FenwickTree2D<TType, TGroup>::valueOnRectangle(std::size_t t_first_row, std::size_t t_first_column,
+                                                         std::size_t t_last_row, std::size_t t_last_column) const {
+        auto inner = this->m_function(prefixCount(t_last_row + 1, t_last_column + 1),
+                                      prefixCount(t_first_row, t_first_column));
+        auto outer = this->m_function(prefixCount(t_first_row, t_last_column + 1),
+                                      prefixCount(t_last_row + 1, t_first_column));
+        return this->m_function(inner, TGroup::inverse(outer));
+    }
+
+}
+
+#endif //COMPETITIVE_ALGORITHMS_FENWICKTREE2D_H
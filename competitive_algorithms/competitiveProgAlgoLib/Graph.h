@@ -7,11 +7,12 @@
 #include <set>
 #include <numeric>
 #include "IEdge.h"
+#include "Stats.h"
 
 namespace cpa {
 
-    template<class TEdge, class TWeight = int>
-    class Graph {
+    template<class TEdge, class TWeight = int, class TStats = NoStats>
+    class Graph : private TStats {
     private:
         typedef std::vector<std::int8_t> mark_list;
         std::vector<TEdge> m_edges;
@@ -34,11 +35,13 @@ namespace cpa {
     public:
         explicit Graph(std::size_t t_vertexCount = 0, bool t_isDirected = false);
 
-        Graph(const Graph<TEdge, TWeight> &other);
+        Graph(std::size_t t_vertexCount, bool t_isDirected, const TStats &t_stats);
 
-        Graph(Graph<TEdge, TWeight> &&other) noexcept;
+        Graph(const Graph<TEdge, TWeight, TStats> &other);
 
-        Graph<TEdge, TWeight> transposedGraph() const noexcept;
+        Graph(Graph<TEdge, TWeight, TStats> &&other) noexcept;
+
+        Graph<TEdge, TWeight, TStats> transposedGraph() const noexcept;
 
         [[nodiscard]] std::size_t vertexCount() const noexcept;
 
@@ -67,29 +70,39 @@ namespace cpa {
         std::pair<std::vector<TWeight>, std::vector<std::size_t>>
         FordBellman(std::size_t t_from, const TWeight &t_minusInf) const;
 
+        template<class TPolicy = TStats>
+        [[nodiscard]] auto stats() const noexcept -> decltype(std::declval<const TPolicy &>().stats());
+
     };
 
-    template<class TEdge, class TWeight>
-    Graph<TEdge, TWeight>::Graph(std::size_t t_vertexCount, bool t_isDirected) {
+    template<class TEdge, class TWeight, class TStats>
+    Graph<TEdge, TWeight, TStats>::Graph(std::size_t t_vertexCount, bool t_isDirected) {
+        this->m_incidentEdges.assign(t_vertexCount, {});
+        this->m_isDirected = t_isDirected;
+    }
+
+    template<class TEdge, class TWeight, class TStats>
+    Graph<TEdge, TWeight, TStats>::Graph(std::size_t t_vertexCount, bool t_isDirected, const TStats &t_stats) :
+            TStats(t_stats) {
         this->m_incidentEdges.assign(t_vertexCount, {});
         this->m_isDirected = t_isDirected;
     }
 
-    template<class TEdge, class TWeight>
-    Graph<TEdge, TWeight>::Graph(const Graph<TEdge, TWeight> &other) {
+    template<class TEdge, class TWeight, class TStats>
+    Graph<TEdge, TWeight, TStats>::Graph(const Graph<TEdge, TWeight, TStats> &other) : TStats(other) {
         this->m_edges = other.m_edges;
         this->m_incidentEdges = other.m_incidentEdges;
     }
 
-    template<class TEdge, class TWeight>
-    Graph<TEdge, TWeight>::Graph(Graph<TEdge, TWeight> &&other) noexcept {
+    template<class TEdge, class TWeight, class TStats>
+    Graph<TEdge, TWeight, TStats>::Graph(Graph<TEdge, TWeight, TStats> &&other) noexcept : TStats(other) {
         this->m_edges = std::move(other.m_edges);
         this->m_incidentEdges = std::move(other.m_incidentEdges);
     }
 
-    template<class TEdge, class TWeight>
-    Graph<TEdge, TWeight> Graph<TEdge, TWeight>::transposedGraph() const noexcept {
-        Graph<TEdge, TWeight> transposedGraph(*this);
+    template<class TEdge, class TWeight, class TStats>
+    Graph<TEdge, TWeight, TStats> Graph<TEdge, TWeight, TStats>::transposedGraph() const noexcept {
+        Graph<TEdge, TWeight, TStats> transposedGraph(*this);
         transposedGraph.m_incidentEdges.assign(transposedGraph.vertexCount(), {});
         for (auto i = 0u; i < transposedGraph.m_edges.size(); ++i) {
             auto &e = transposedGraph.m_edges[i];
@@ -99,26 +112,26 @@ namespace cpa {
         return transposedGraph;
     }
 
-    template<class TEdge, class TWeight>
-    std::size_t Graph<TEdge, TWeight>::vertexCount() const noexcept {
+    template<class TEdge, class TWeight, class TStats>
+    std::size_t Graph<TEdge, TWeight, TStats>::vertexCount() const noexcept {
         return m_incidentEdges.size();
     }
 
-    template<class TEdge, class TWeight>
-    std::size_t Graph<TEdge, TWeight>::edgeCount() const noexcept {
+    template<class TEdge, class TWeight, class TStats>
+    std::size_t Graph<TEdge, TWeight, TStats>::edgeCount() const noexcept {
         if (m_isDirected) {
             return m_edges.size();
         }
         return m_edges.size() / 2;
     }
 
-    template<class TEdge, class TWeight>
-    bool Graph<TEdge, TWeight>::isDirected() const noexcept {
+    template<class TEdge, class TWeight, class TStats>
+    bool Graph<TEdge, TWeight, TStats>::isDirected() const noexcept {
         return this->m_isDirected;
     }
 
-    template<class TEdge, class TWeight>
-    void Graph<TEdge, TWeight>::addEdge(const TEdge &t_edge) {
+    template<class TEdge, class TWeight, class TStats>
+    void Graph<TEdge, TWeight, TStats>::addEdge(const TEdge &t_edge) {
         this->m_incidentEdges[t_edge.from()].push_back(this->m_edges.size());
         this->m_edges.push_back(t_edge);
         if (!m_isDirected) {
@@ -129,10 +142,10 @@ namespace cpa {
         }
     }
 
-    template<class TEdge, class TWeight>
-    std::vector<std::vector<std::size_t>> Graph<TEdge, TWeight>::connectivityComponents() const {
+    template<class TEdge, class TWeight, class TStats>
+    std::vector<std::vector<std::size_t>> Graph<TEdge, TWeight, TStats>::connectivityComponents() const {
         if (this->m_isDirected) {
-            Graph<TEdge, TWeight> g(this->vertexCount(), false);
+            Graph<TEdge, TWeight, TStats> g(this->vertexCount(), false, *this);
             for (auto &e : this->edges()) {
                 g.addEdge(e);
             }
@@ -140,6 +153,7 @@ namespace cpa {
         }
         std::vector<std::vector<std::size_t>> comp;
         mark_list was(this->vertexCount());
+        countAllocation<TStats>(*this, was);
         for (std::size_t startV = 0; startV < was.size(); ++startV) {
             if (!was[startV]) {
                 std::queue<std::size_t> q;
@@ -151,6 +165,7 @@ namespace cpa {
                     q.pop();
                     comp.back().push_back(v);
                     for (auto &i : this->m_incidentEdges[v]) {
+                        this->visit();
                         auto u = this->m_edges[i].to();
                         if (!was[u]) {
                             q.push(u);
@@ -163,10 +178,11 @@ namespace cpa {
         return comp;
     }
 
-    template<class TEdge, class TWeight>
-    std::vector<std::size_t> Graph<TEdge, TWeight>::topologicalSort() const {
+    template<class TEdge, class TWeight, class TStats>
+    std::vector<std::size_t> Graph<TEdge, TWeight, TStats>::topologicalSort() const {
         std::vector<std::size_t> order;
         mark_list was(this->vertexCount());
+        countAllocation<TStats>(*this, was);
         for (std::size_t v = 0; v < was.size(); ++v) {
             if (!was[v]) {
                 topologicalSortDfs(v, was, order);
@@ -176,12 +192,13 @@ namespace cpa {
         return order;
     }
 
-    template<class TEdge, class TWeight>
+    template<class TEdge, class TWeight, class TStats>
     void
-    Graph<TEdge, TWeight>::topologicalSortDfs(std::size_t t_from, mark_list &t_was,
-                                              std::vector<std::size_t> &t_order) const {
+    Graph<TEdge, TWeight, TStats>::topologicalSortDfs(std::size_t t_from, mark_list &t_was,
+                                                      std::vector<std::size_t> &t_order) const {
         t_was[t_from] = true;
         for (auto &i : this->m_incidentEdges[t_from]) {
+            this->visit();
             auto to = this->m_edges[i].to();
             if (!t_was[to]) {
                 topologicalSortDfs(to, t_was, t_order);
@@ -190,11 +207,12 @@ namespace cpa {
         t_order.push_back(t_from);
     }
 
-    template<class TEdge, class TWeight>
-    std::vector<std::vector<std::size_t>> Graph<TEdge, TWeight>::strongConnectivityComponents() const {
+    template<class TEdge, class TWeight, class TStats>
+    std::vector<std::vector<std::size_t>> Graph<TEdge, TWeight, TStats>::strongConnectivityComponents() const {
         auto rGragh = this->transposedGraph();
         std::vector<std::vector<std::size_t>> comps;
         mark_list was(this->vertexCount());
+        countAllocation<TStats>(*this, was);
         for (auto v : this->topologicalSort()) {
             if (!was[v]) {
                 comps.emplace_back();
@@ -204,11 +222,12 @@ namespace cpa {
         return comps;
     }
 
-    template<class TEdge, class TWeight>
-    std::vector<TEdge> Graph<TEdge, TWeight>::bridges() const {
+    template<class TEdge, class TWeight, class TStats>
+    std::vector<TEdge> Graph<TEdge, TWeight, TStats>::bridges() const {
         mark_list was(this->vertexCount());
         std::vector<std::size_t> tin(this->vertexCount()), fup(this->vertexCount());
         mark_list is_bridge(this->edgeCount() * 2);
+        countAllocation<TStats>(*this, was, tin, fup, is_bridge);
         std::size_t timer = 0;
         for (std::size_t v = 0; v < was.size(); ++v) {
             if (!was[v]) {
@@ -225,14 +244,15 @@ namespace cpa {
         return bridgesList;
     }
 
-    template<class TEdge, class TWeight>
-    void Graph<TEdge, TWeight>::findBridge(std::size_t t_from, int t_parentEdge, Graph::mark_list &was,
-                                           std::vector<std::size_t> &t_tin, std::vector<std::size_t> &t_fup,
-                                           size_t &timer,
-                                           mark_list &t_is_bridge) const {
+    template<class TEdge, class TWeight, class TStats>
+    void Graph<TEdge, TWeight, TStats>::findBridge(std::size_t t_from, int t_parentEdge, Graph::mark_list &was,
+                                                   std::vector<std::size_t> &t_tin, std::vector<std::size_t> &t_fup,
+                                                   size_t &timer,
+                                                   mark_list &t_is_bridge) const {
         was[t_from] = true;
         t_tin[t_from] = t_fup[t_from] = timer++;
         for (auto &i : this->m_incidentEdges[t_from]) {
+            this->visit();
             if ((i ^ 1u) == t_parentEdge) {
                 continue;
             }
@@ -249,12 +269,13 @@ namespace cpa {
         }
     }
 
-    template<class TEdge, class TWeight>
-    std::vector<std::size_t> Graph<TEdge, TWeight>::cutVertexes() const {
+    template<class TEdge, class TWeight, class TStats>
+    std::vector<std::size_t> Graph<TEdge, TWeight, TStats>::cutVertexes() const {
         mark_list was(this->vertexCount());
         std::vector<std::size_t> tin(this->vertexCount()), fup(this->vertexCount());
         std::size_t timer = 0;
         mark_list isCutVertex(this->vertexCount());
+        countAllocation<TStats>(*this, was, tin, fup, isCutVertex);
         for (std::size_t v = 0; v < was.size(); ++v) {
             if (!was[v]) {
                 findCutVertexes(v, -1, was, tin, fup, timer, isCutVertex);
@@ -269,14 +290,16 @@ namespace cpa {
         return cutVertexesList;
     }
 
-    template<class TEdge, class TWeight>
-    void Graph<TEdge, TWeight>::findCutVertexes(std::size_t t_from, int t_parentEdge, Graph::mark_list &was,
-                                                std::vector<std::size_t> &t_tin, std::vector<std::size_t> &t_fup,
-                                                size_t &timer, Graph::mark_list &isCutVertex) const {
+    template<class TEdge, class TWeight, class TStats>
+    void Graph<TEdge, TWeight, TStats>::findCutVertexes(std::size_t t_from, int t_parentEdge, Graph::mark_list &was,
+                                                        std::vector<std::size_t> &t_tin,
+                                                        std::vector<std::size_t> &t_fup,
+                                                        size_t &timer, Graph::mark_list &isCutVertex) const {
         was[t_from] = true;
         t_tin[t_from] = t_fup[t_from] = timer++;
         std::size_t dfsCount = 0;
         for (auto &i : this->m_incidentEdges[t_from]) {
+            this->visit();
             if (i == t_parentEdge) {
                 continue;
             }
@@ -297,21 +320,23 @@ namespace cpa {
         }
     }
 
-    template<class TEdge, class TWeight>
+    template<class TEdge, class TWeight, class TStats>
     std::pair<std::vector<TWeight>, std::vector<std::size_t>>
-    Graph<TEdge, TWeight>::Dijkstra(std::size_t t_from) const {
+    Graph<TEdge, TWeight, TStats>::Dijkstra(std::size_t t_from) const {
         std::size_t n = this->vertexCount();
         std::vector<TWeight> dist(n, TWeight());
         std::vector<std::size_t> parent(n);
         std::iota(parent.begin(), parent.end(), 0);
         mark_list initialDist(n);
         std::set<std::pair<TWeight, std::size_t>> q;
+        countAllocation<TStats>(*this, dist, parent, initialDist);
         initialDist[t_from] = 1;
         q.emplace(dist[t_from], t_from);
         while (!q.empty()) {
             auto[d, v] = *q.begin();
             q.erase(q.begin());
             for (auto &i : this->m_incidentEdges[v]) {
+                this->visit();
                 auto u = this->m_edges[i].to();
                 auto nd = d + this->m_edges[i].getWeight();
                 if (!initialDist[u]) {
@@ -330,9 +355,10 @@ namespace cpa {
         return {dist, parent};
     }
 
-    template<class TEdge, class TWeight>
-    bool Graph<TEdge, TWeight>::isAcyclic() const {
+    template<class TEdge, class TWeight, class TStats>
+    bool Graph<TEdge, TWeight, TStats>::isAcyclic() const {
         mark_list colors(this->vertexCount());
+        countAllocation<TStats>(*this, colors);
         for (std::size_t v = 0; v < colors.size(); ++v) {
             if (colors[v] == 0) {
                 if (checkCycleDfs(v, -1, colors)) {
@@ -343,10 +369,12 @@ namespace cpa {
         return true;
     }
 
-    template<class TEdge, class TWeight>
-    bool Graph<TEdge, TWeight>::checkCycleDfs(std::size_t t_from, int t_parentEdge, Graph::mark_list &t_colors) const {
+    template<class TEdge, class TWeight, class TStats>
+    bool Graph<TEdge, TWeight, TStats>::checkCycleDfs(std::size_t t_from, int t_parentEdge,
+                                                      Graph::mark_list &t_colors) const {
         t_colors[t_from]++;
         for (auto &i : this->m_incidentEdges[t_from]) {
+            this->visit();
             if (!m_isDirected && ((i ^ 1) == t_parentEdge)) {
                 continue;
             }
@@ -363,19 +391,21 @@ namespace cpa {
         return false;
     }
 
-    template<class TEdge, class TWeight>
+    template<class TEdge, class TWeight, class TStats>
     std::pair<std::vector<TWeight>, std::vector<std::size_t>>
-    Graph<TEdge, TWeight>::FordBellman(std::size_t t_from, const TWeight &t_minusInf) const {
+    Graph<TEdge, TWeight, TStats>::FordBellman(std::size_t t_from, const TWeight &t_minusInf) const {
         std::size_t n = this->vertexCount();
         std::vector<TWeight> dist(n, TWeight());
         std::vector<std::size_t> parent(n);
         std::iota(parent.begin(), parent.end(), 0);
         mark_list initialDist(n);
         initialDist[t_from] = 1;
+        countAllocation<TStats>(*this, dist, parent, initialDist);
 
         for (std::size_t i = 1; i < n; ++i) {
             bool condensate = false;
             for (auto &e : this->m_edges) {
+                this->visit();
                 if (!initialDist[e.from()]) {
                     continue;
                 }
@@ -394,7 +424,9 @@ namespace cpa {
         }
 
         mark_list was(n);
+        countAllocation<TStats>(*this, was);
         for (auto &e : this->m_edges) {
+            this->visit();
             if (!initialDist[e.from()]) {
                 continue;
             }
@@ -410,6 +442,7 @@ namespace cpa {
                         auto v = q.front();
                         q.pop();
                         for (auto &i : this->m_incidentEdges[v]) {
+                            this->visit();
                             auto u = this->m_edges[i].to();
                             if (!was[u]) {
                                 dist[u] = t_minusInf;
@@ -425,11 +458,17 @@ namespace cpa {
         return {dist, parent};
     }
 
-    template<class TEdge, class TWeight>
-    std::vector<TEdge> Graph<TEdge, TWeight>::edges() const {
+    template<class TEdge, class TWeight, class TStats>
+    std::vector<TEdge> Graph<TEdge, TWeight, TStats>::edges() const {
         return this->m_edges;
     }
 
+    template<class TEdge, class TWeight, class TStats>
+    template<class TPolicy>
+    auto Graph<TEdge, TWeight, TStats>::stats() const noexcept -> decltype(std::declval<const TPolicy &>().stats()) {
+        return static_cast<const TPolicy &>(*this).stats();
+    }
+
 
 }
 
@@ -0,0 +1,146 @@
+#ifndef COMPETITIVE_ALGORITHMS_GROUPFENWICKTREE_H
+#define COMPETITIVE_ALGORITHMS_GROUPFENWICKTREE_H
+
+#include <vector>
+#include "IMutableDataStructure.h"
+#include "ISegmentSolver.h"
+#include "Intrinsics.h"
+
+namespace cpa {
+
+    template<class TType, class TGroup = Sum<TType>>
+    class GroupFenwickTree :
+            public IMutableDataStructure<GroupFenwickTree<TType, TGroup>, TType>,
+            public ISegmentSolver<GroupFenwickTree<TType, TGroup>, TType, TGroup> {
+        static_assert(MonoidTraits<TGroup>::invertible, "GroupFenwickTree requires an invertible operation");
+
+    private:
+        std::vector<TType> m_tree;
+
+        template<class TIter>
+        void build(TIter t_begin, TIter t_end);
+
+        void propagate(std::size_t t_index, const TType &t_delta);
+
+    public:
+        explicit GroupFenwickTree(const TGroup &t_function = TGroup());
+
+        template<class TIter>
+        GroupFenwickTree(TIter t_begin, TIter t_end, const TGroup &t_function = TGroup());
+
+        GroupFenwickTree(const GroupFenwickTree<TType, TGroup> &other);
+
+        GroupFenwickTree(GroupFenwickTree<TType, TGroup> &&other) noexcept;
+
+        TType getValueAt(std::size_t t_index) const;
+
+        void changeValueAt(std::size_t t_index, const TType &t_value);
+
+        void addValueAt(std::size_t t_index, const TType &t_delta);
+
+        TType prefix(std::size_t t_index) const;
+
+        TType valueOnSegment(std::size_t t_left_index, std::size_t t_right_index) const;
+
+        std::size_t lowerBound(const TType &t_prefix_target) const;
+    };
+
+    template<class TType, class TGroup>
+    GroupFenwickTree<TType, TGroup>::GroupFenwickTree(const TGroup &t_function) {
+        this->m_function = t_function;
+    }
+
+    template<class TType, class TGroup>
+    template<class TIter>
+    GroupFenwickTree<TType, TGroup>::GroupFenwickTree(TIter t_begin, TIter t_end, const TGroup &t_function) {
+        this->m_function = t_function;
+        build(t_begin, t_end);
+    }
+
+    template<class TType, class TGroup>
+    GroupFenwickTree<TType, TGroup>::GroupFenwickTree(const GroupFenwickTree<TType, TGroup> &other) {
+        this->m_function = other.m_function;
+        this->m_size = other.m_size;
+        this->m_tree = other.m_tree;
+    }
+
+    template<class TType, class TGroup>
+    GroupFenwickTree<TType, TGroup>::GroupFenwickTree(GroupFenwickTree<TType, TGroup> &&other) noexcept {
+        this->m_function = std::move(other.m_function);
+        this->m_size = std::move(other.m_size);
+        this->m_tree = std::move(other.m_tree);
+    }
+
+    template<class TType, class TGroup>
+    template<class TIter>
+    void GroupFenwickTree<TType, TGroup>::build(TIter t_begin, TIter t_end) {
+        this->m_tree.assign(1, TGroup::identity());
+        this->m_tree.insert(this->m_tree.end(), t_begin, t_end);
+        this->m_size = this->m_tree.size() - 1;
+        for (std::size_t i = 1; i <= this->m_size; ++i) {
+            auto parent = i + (i & (~i + 1));
+            if (parent <= this->m_size) {
+                this->m_tree[parent] = this->m_function(this->m_tree[parent], this->m_tree[i]);
+            }
+        }
+    }
+
+    template<class TType, class TGroup>
+    void GroupFenwickTree<TType, TGroup>::propagate(std::size_t t_index, const TType &t_delta) {
+        for (auto i = t_index + 1; i <= this->m_size; i += i & (~i + 1)) {
+            this->m_tree[i] = this->m_function(this->m_tree[i], t_delta);
+        }
+    }
+
+    template<class TType, class TGroup>
+    TType GroupFenwickTree<TType, TGroup>::getValueAt(std::size_t t_index) const {
+        return this->valueOnSegment(t_index, t_index);
+    }
+
+    template<class TType, class TGroup>
+    void GroupFenwickTree<TType, TGroup>::changeValueAt(std::size_t t_index, const TType &t_value) {
+        propagate(t_index, this->m_function(t_value, TGroup::inverse(this->getValueAt(t_index))));
+    }
+
+    template<class TType, class TGroup>
+    void GroupFenwickTree<TType, TGroup>::addValueAt(std::size_t t_index, const TType &t_delta) {
+        propagate(t_index, t_delta);
+    }
+
+    template<class TType, class TGroup>
+    TType GroupFenwickTree<TType, TGroup>::prefix(std::size_t t_index) const {
+        auto result = TGroup::identity();
+        for (auto i = t_index + 1; i > 0; i &= i - 1) {
+            result = this->m_function(result, this->m_tree[i]);
+        }
+        return result;
+    }
+
+    template<class TType, class TGroup>
+    TType GroupFenwickTree<TType, TGroup>::valueOnSegment(std::size_t t_left_index, std::size_t t_right_index) const {
+        if (t_left_index == 0) {
+            return prefix(t_right_index);
+        }
+        return this->m_function(prefix(t_right_index), TGroup::inverse(prefix(t_left_index - 1)));
+    }
+
+    template<class TType, class TGroup>
+    std::size_t GroupFenwickTree<TType, TGroup>::lowerBound(const TType &t_prefix_target) const {
+        std::size_t position = 0;
+        auto accumulated = TGroup::identity();
+        for (auto step = this->m_size == 0 ? 0 : std::size_t{1} << (bitWidth(this->m_size) - 1); step > 0;
+             step >>= 1u) {
+            if (position + step <= this->m_size) {
+                auto candidate = this->m_function(accumulated, this->m_tree[position + step]);
+                if (candidate < t_prefix_target) {
+                    position += step;
+                    accumulated = candidate;
+                }
+            }
+        }
+        return position;
+    }
+
+}
+
+#endif //COMPETITIVE_ALGORITHMS_GROUPFENWICKTREE_H
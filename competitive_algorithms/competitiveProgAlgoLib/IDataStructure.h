@@ -2,25 +2,56 @@
 #define COMPETITIVE_ALGORITHMS_IDATASTRUCTURE_H
 
 #include <cstdlib>
+#include <type_traits>
 
 namespace cpa {
 
-    template<class TType>
+    template<class TDerived, class TType>
     class IDataStructure {
+    private:
+        template<class TClass, class TResult>
+        static constexpr bool overrides(TResult (TClass::*)(std::size_t) const) noexcept;
+
     protected:
         std::size_t m_size{};
+
+        ~IDataStructure();
+
+        [[nodiscard]] const TDerived &derived() const noexcept;
     public:
         [[nodiscard]]
         std::size_t size() const noexcept;
 
-        virtual const TType &getValueAt(std::size_t t_index) const = 0;
+        TType getValueAt(std::size_t t_index) const;
     };
 
-    template<class TType>
-    std::size_t IDataStructure<TType>::size() const noexcept {
+    template<class TDerived, class TType>
+    template<class TClass, class TResult>
+    constexpr bool IDataStructure<TDerived, TType>::overrides(TResult (TClass::*)(std::size_t) const) noexcept {
+        return !std::is_same_v<TClass, IDataStructure<TDerived, TType>>;
+    }
+
+    template<class TDerived, class TType>
+    IDataStructure<TDerived, TType>::~IDataStructure() {
+        static_assert(overrides(&TDerived::getValueAt), "IDataStructure requires TDerived::getValueAt");
+    }
+
+    template<class TDerived, class TType>
+    const TDerived &IDataStructure<TDerived, TType>::derived() const noexcept {
+        return static_cast<const TDerived &>(*this);
+    }
+
+    template<class TDerived, class TType>
+    std::size_t IDataStructure<TDerived, TType>::size() const noexcept {
         return this->m_size;
     }
 
+    template<class TDerived, class TType>
+    TType IDataStructure<TDerived, TType>::getValueAt(std::size_t t_index) const {
+        static_assert(overrides(&TDerived::getValueAt), "IDataStructure requires TDerived::getValueAt");
+        return this->derived().getValueAt(t_index);
+    }
+
 }
 
 #endif //COMPETITIVE_ALGORITHMS_IDATASTRUCTURE_H
@@ -0,0 +1,67 @@
+#ifndef COMPETITIVE_ALGORITHMS_IGRIDDATASTRUCTURE_H
+#define COMPETITIVE_ALGORITHMS_IGRIDDATASTRUCTURE_H
+
+#include <cstdlib>
+#include <type_traits>
+
+namespace cpa {
+
+    template<class TDerived, class TType>
+    class IGridDataStructure {
+    private:
+        template<class TClass, class TResult>
+        static constexpr bool overrides(TResult (TClass::*)(std::size_t, std::size_t) const) noexcept;
+
+    protected:
+        std::size_t m_rows{};
+        std::size_t m_columns{};
+
+        ~IGridDataStructure();
+
+        [[nodiscard]] const TDerived &derived() const noexcept;
+    public:
+        [[nodiscard]]
+        std::size_t rows() const noexcept;
+
+        [[nodiscard]]
+        std::size_t columns() const noexcept;
+
+        TType getValueAt(std::size_t t_row, std::size_t t_column) const;
+    };
+
+    template<class TDerived, class TType>
+    template<class TClass, class TResult>
+    constexpr bool IGridDataStructure<TDerived, TType>::overrides(
+            TResult (TClass::*)(std::size_t, std::size_t) const) noexcept {
+        return !std::is_same_v<TClass, IGridDataStructure<TDerived, TType>>;
+    }
+
+    template<class TDerived, class TType>
+    IGridDataStructure<TDerived, TType>::~IGridDataStructure() {
+        static_assert(overrides(&TDerived::getValueAt), "IGridDataStructure requires TDerived::getValueAt");
+    }
+
+    template<class TDerived, class TType>
+    const TDerived &IGridDataStructure<TDerived, TType>::derived() const noexcept {
+        return static_cast<const TDerived &>(*this);
+    }
+
+    template<class TDerived, class TType>
+    std::size_t IGridDataStructure<TDerived, TType>::rows() const noexcept {
+        return this->m_rows;
+    }
+
+    template<class TDerived, class TType>
+    std::size_t IGridDataStructure<TDerived, TType>::columns() const noexcept {
+        return this->m_columns;
+    }
+
+    template<class TDerived, class TType>
+    TType IGridDataStructure<TDerived, TType>::getValueAt(std::size_t t_row, std::size_t t_column) const {
+        static_assert(overrides(&TDerived::getValueAt), "IGridDataStructure requires TDerived::getValueAt");
+        return this->derived().getValueAt(t_row, t_column);
+    }
+
+}
+
+#endif //COMPETITIVE_ALGORITHMS_IGRIDDATASTRUCTURE_H
@@ -1,16 +1,48 @@
 #ifndef COMPETITIVE_ALGORITHMS_IMUTABLEDATASTRUCTURE_H
 #define COMPETITIVE_ALGORITHMS_IMUTABLEDATASTRUCTURE_H
 
+#include <type_traits>
 #include "IDataStructure.h"
 
 namespace cpa {
 
-    template<class TType>
-    class IMutableDataStructure : public IDataStructure<TType> {
+    template<class TDerived, class TType>
+    class IMutableDataStructure : public IDataStructure<TDerived, TType> {
+    private:
+        template<class TClass>
+        static constexpr bool overrides(void (TClass::*)(std::size_t, const TType &)) noexcept;
+
+    protected:
+        ~IMutableDataStructure();
+
+        [[nodiscard]] TDerived &derived() noexcept;
     public:
-        virtual void changeValueAt(std::size_t t_index, const TType& t_value) = 0;
+        void changeValueAt(std::size_t t_index, const TType &t_value);
     };
 
+    template<class TDerived, class TType>
+    template<class TClass>
+    constexpr bool IMutableDataStructure<TDerived, TType>::overrides(
+            void (TClass::*)(std::size_t, const TType &)) noexcept {
+        return !std::is_same_v<TClass, IMutableDataStructure<TDerived, TType>>;
+    }
+
+    template<class TDerived, class TType>
+    IMutableDataStructure<TDerived, TType>::~IMutableDataStructure() {
+        static_assert(overrides(&TDerived::changeValueAt), "IMutableDataStructure requires TDerived::changeValueAt");
+    }
+
+    template<class TDerived, class TType>
+    TDerived &IMutableDataStructure<TDerived, TType>::derived() noexcept {
+        return static_cast<TDerived &>(*this);
+    }
+
+    template<class TDerived, class TType>
+    void IMutableDataStructure<TDerived, TType>::changeValueAt(std::size_t t_index, const TType &t_value) {
+        static_assert(overrides(&TDerived::changeValueAt), "IMutableDataStructure requires TDerived::changeValueAt");
+        this->derived().changeValueAt(t_index, t_value);
+    }
+
 }
 
 #endif //COMPETITIVE_ALGORITHMS_IMUTABLEDATASTRUCTURE_H
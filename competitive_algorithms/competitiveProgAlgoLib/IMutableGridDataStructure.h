@@ -0,0 +1,51 @@
+#ifndef COMPETITIVE_ALGORITHMS_IMUTABLEGRIDDATASTRUCTURE_H
+#define COMPETITIVE_ALGORITHMS_IMUTABLEGRIDDATASTRUCTURE_H
+
+#include <type_traits>
+#include "IGridDataStructure.h"
+
+namespace cpa {
+
+    template<class TDerived, class TType>
+    class IMutableGridDataStructure : public IGridDataStructure<TDerived, TType> {
+    private:
+        template<class TClass>
+        static constexpr bool overrides(void (TClass::*)(std::size_t, std::size_t, const TType &)) noexcept;
+
+    protected:
+        ~IMutableGridDataStructure();
+
+        [[nodiscard]] TDerived &derived() noexcept;
+    public:
+        void changeValueAt(std::size_t t_row, std::size_t t_column, const TType &t_value);
+    };
+
+    template<class TDerived, class TType>
+    template<class TClass>
+    constexpr bool IMutableGridDataStructure<TDerived, TType>::overrides(
+            void (TClass::*)(std::size_t, std::size_t, const TType &)) noexcept {
+        return !std::is_same_v<TClass, IMutableGridDataStructure<TDerived, TType>>;
+    }
+
+    template<class TDerived, class TType>
+    IMutableGridDataStructure<TDerived, TType>::~IMutableGridDataStructure() {
+        static_assert(overrides(&TDerived::changeValueAt),
+                      "IMutableGridDataStructure requires TDerived::changeValueAt");
+    }
+
+    template<class TDerived, class TType>
+    TDerived &IMutableGridDataStructure<TDerived, TType>::derived() noexcept {
+        return static_cast<TDerived &>(*this);
+    }
+
+    template<class TDerived, class TType>
+    void IMutableGridDataStructure<TDerived, TType>::changeValueAt(std::size_t t_row, std::size_t t_column,
+                                                                   const TType &t_value) {
+        static_assert(overrides(&TDerived::changeValueAt),
+                      "IMutableGridDataStructure requires TDerived::changeValueAt");
+        this->derived().changeValueAt(t_row, t_column, t_value);
+    }
+
+}
+
+#endif //COMPETITIVE_ALGORITHMS_IMUTABLEGRIDDATASTRUCTURE_H
@@ -0,0 +1,67 @@
+#ifndef COMPETITIVE_ALGORITHMS_IRECTANGLESOLVER_H
+#define COMPETITIVE_ALGORITHMS_IRECTANGLESOLVER_H
+
+#include <functional>
+#include <type_traits>
+#include "Monoid.h"
+#include "Stats.h"
+
+namespace cpa {
+
+    template<class TDerived, class TType, class TFunction = std::function<TType(const TType &, const TType &)>,
+            class TIndex = std::size_t>
+    class IRectangleSolver {
+    private:
+        template<class TClass, class TResult>
+        static constexpr bool overrides(TResult (TClass::*)(TIndex, TIndex, TIndex, TIndex) const) noexcept;
+
+    protected:
+        TFunction m_function;
+
+        ~IRectangleSolver();
+
+        [[nodiscard]] const TDerived &derived() const noexcept;
+    public:
+        TType valueOnRectangle(TIndex t_first_row, TIndex t_first_column,
+                               TIndex t_last_row, TIndex t_last_column) const;
+
+        template<class TPolicy = TFunction>
+        [[nodiscard]] auto stats() const noexcept -> decltype(std::declval<const TPolicy &>().stats());
+    };
+
+    template<class TDerived, class TType, class TFunction, class TIndex>
+    template<class TClass, class TResult>
+    constexpr bool IRectangleSolver<TDerived, TType, TFunction, TIndex>::overrides(
+            TResult (TClass::*)(TIndex, TIndex, TIndex, TIndex) const) noexcept {
+        return !std::is_same_v<TClass, IRectangleSolver<TDerived, TType, TFunction, TIndex>>;
+    }
+
+    template<class TDerived, class TType, class TFunction, class TIndex>
+    IRectangleSolver<TDerived, TType, TFunction, TIndex>::~IRectangleSolver() {
+        static_assert(overrides(&TDerived::valueOnRectangle), "IRectangleSolver requires TDerived::valueOnRectangle");
+    }
+
+    template<class TDerived, class TType, class TFunction, class TIndex>
+    const TDerived &IRectangleSolver<TDerived, TType, TFunction, TIndex>::derived() const noexcept {
+        return static_cast<const TDerived &>(*this);
+    }
+
+    template<class TDerived, class TType, class TFunction, class TIndex>
+    TType IRectangleSolver<TDerived, TType, TFunction, TIndex>::valueOnRectangle(TIndex t_first_row,
+                                                                                 TIndex t_first_column,
+                                                                                 TIndex t_last_row,
+                                                                                 TIndex t_last_column) const {
+        static_assert(overrides(&TDerived::valueOnRectangle), "IRectangleSolver requires TDerived::valueOnRectangle");
+        return this->derived().valueOnRectangle(t_first_row, t_first_column, t_last_row, t_last_column);
+    }
+
+    template<class TDerived, class TType, class TFunction, class TIndex>
+    template<class TPolicy>
+    auto IRectangleSolver<TDerived, TType, TFunction, TIndex>::stats() const noexcept
+    -> decltype(std::declval<const TPolicy &>().stats()) {
+        return this->m_function.stats();
+    }
+
+}
+
+#endif //COMPETITIVE_ALGORITHMS_IRECTANGLESOLVER_H
@@ -2,18 +2,102 @@
 #define COMPETITIVE_ALGORITHMS_ISEGMENTSOLVER_H
 
 #include <functional>
+#include <type_traits>
+#include <utility>
 #include <vector>
+#include "Monoid.h"
+#include "Stats.h"
 
 namespace cpa {
 
-    template<class TType, class TFunction = std::function<TType(const TType&, const TType&)>>
+    template<class TDerived, class TType, class TFunction = std::function<TType(const TType&, const TType&)>>
     class ISegmentSolver {
+    private:
+        template<class TClass>
+        static constexpr bool overrides(void (TClass::*)(const std::vector<std::pair<std::size_t, std::size_t>> &,
+                                                         std::vector<TType> &) const) noexcept;
+
+        template<class TClass, class TResult>
+        static constexpr bool overrides(TResult (TClass::*)(std::size_t, std::size_t) const) noexcept;
+
     protected:
         TFunction m_function;
+
+        ~ISegmentSolver();
+
+        [[nodiscard]] const TDerived &derived() const noexcept;
+
+        void valueOnSegmentsDefault(const std::vector<std::pair<std::size_t, std::size_t>> &t_queries,
+                                    std::vector<TType> &t_result) const;
     public:
-        virtual TType valueOnSegment(std::size_t t_left_index, std::size_t t_right_index) const = 0;
+        TType valueOnSegment(std::size_t t_left_index, std::size_t t_right_index) const;
+
+        void valueOnSegments(const std::vector<std::pair<std::size_t, std::size_t>> &t_queries,
+                             std::vector<TType> &t_result) const;
+
+        template<class TPolicy = TFunction>
+        [[nodiscard]] auto stats() const noexcept -> decltype(std::declval<const TPolicy &>().stats());
     };
 
+    template<class TDerived, class TType, class TFunction>
+    template<class TClass>
+    constexpr bool ISegmentSolver<TDerived, TType, TFunction>::overrides(
+            void (TClass::*)(const std::vector<std::pair<std::size_t, std::size_t>> &,
+                             std::vector<TType> &) const) noexcept {
+        return !std::is_same_v<TClass, ISegmentSolver<TDerived, TType, TFunction>>;
+    }
+
+    template<class TDerived, class TType, class TFunction>
+    template<class TClass, class TResult>
+    constexpr bool ISegmentSolver<TDerived, TType, TFunction>::overrides(
+            TResult (TClass::*)(std::size_t, std::size_t) const) noexcept {
+        return !std::is_same_v<TClass, ISegmentSolver<TDerived, TType, TFunction>>;
+    }
+
+    template<class TDerived, class TType, class TFunction>
+    ISegmentSolver<TDerived, TType, TFunction>::~ISegmentSolver() {
+        static_assert(overrides(&TDerived::valueOnSegment), "ISegmentSolver requires TDerived::valueOnSegment");
+    }
+
+    template<class TDerived, class TType, class TFunction>
+    const TDerived &ISegmentSolver<TDerived, TType, TFunction>::derived() const noexcept {
+        return static_cast<const TDerived &>(*this);
+    }
+
+    template<class TDerived, class TType, class TFunction>
+    TType ISegmentSolver<TDerived, TType, TFunction>::valueOnSegment(std::size_t t_left_index,
+                                                                     std::size_t t_right_index) const {
+        static_assert(overrides(&TDerived::valueOnSegment), "ISegmentSolver requires TDerived::valueOnSegment");
+        return this->derived().valueOnSegment(t_left_index, t_right_index);
+    }
+
+    template<class TDerived, class TType, class TFunction>
+    void ISegmentSolver<TDerived, TType, TFunction>::valueOnSegments(
+            const std::vector<std::pair<std::size_t, std::size_t>> &t_queries, std::vector<TType> &t_result) const {
+        if constexpr (overrides(&TDerived::valueOnSegments)) {
+            this->derived().valueOnSegments(t_queries, t_result);
+        } else {
+            this->valueOnSegmentsDefault(t_queries, t_result);
+        }
+    }
+
+    template<class TDerived, class TType, class TFunction>
+    void ISegmentSolver<TDerived, TType, TFunction>::valueOnSegmentsDefault(
+            const std::vector<std::pair<std::size_t, std::size_t>> &t_queries, std::vector<TType> &t_result) const {
+        t_result.clear();
+        t_result.reserve(t_queries.size());
+        for (auto &[l, r] : t_queries) {
+            t_result.push_back(this->derived().valueOnSegment(l, r));
+        }
+    }
+
+    template<class TDerived, class TType, class TFunction>
+    template<class TPolicy>
+    auto ISegmentSolver<TDerived, TType, TFunction>::stats() const noexcept
+    -> decltype(std::declval<const TPolicy &>().stats()) {
+        return this->m_function.stats();
+    }
+
 }
 
 #endif //COMPETITIVE_ALGORITHMS_ISEGMENTSOLVER_H
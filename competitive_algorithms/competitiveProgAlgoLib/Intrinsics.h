@@ -0,0 +1,70 @@
+#ifndef COMPETITIVE_ALGORITHMS_INTRINSICS_H
+#define COMPETITIVE_ALGORITHMS_INTRINSICS_H
+
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#include <xmmintrin.h>
+#endif
+
+namespace cpa {
+
+    inline void prefetch(const void *t_address) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(t_address);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+        _mm_prefetch(static_cast<const char *>(t_address), _MM_HINT_T0);
+#else
+        (void) t_address;
+#endif
+    }
+
+    inline void cpuRelax() noexcept {
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+        __builtin_ia32_pause();
+#elif (defined(__GNUC__) || defined(__clang__)) && defined(__aarch64__)
+        asm volatile("yield");
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+        _mm_pause();
+#endif
+    }
+
+    inline std::size_t bitWidth(std::size_t t_value) noexcept {
+        if (t_value == 0) {
+            return 0;
+        }
+#if defined(__GNUC__) || defined(__clang__)
+        return std::numeric_limits<unsigned long long>::digits - __builtin_clzll(t_value);
+#elif defined(_MSC_VER) && defined(_M_X64)
+        unsigned long index;
+        _BitScanReverse64(&index, t_value);
+        return index + 1;
+#else
+        std::size_t width = 0;
+        for (; t_value != 0; t_value >>= 1u) {
+            ++width;
+        }
+        return width;
+#endif
+    }
+
+    inline std::size_t popcount(std::uint64_t t_value) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_popcountll(t_value);
+#elif defined(_MSC_VER) && defined(_M_X64)
+        return __popcnt64(t_value);
+#else
+        std::size_t count = 0;
+        for (; t_value != 0; t_value &= t_value - 1) {
+            ++count;
+        }
+        return count;
+#endif
+    }
+
+}
+
+#endif //COMPETITIVE_ALGORITHMS_INTRINSICS_H
@@ -0,0 +1,78 @@
+#ifndef COMPETITIVE_ALGORITHMS_LAZYACTION_H
+#define COMPETITIVE_ALGORITHMS_LAZYACTION_H
+
+#include <cstdlib>
+#include <optional>
+#include <utility>
+
+namespace cpa {
+
+    template<class TType, bool t_scale_by_length = false>
+    struct AddAction {
+        using tag_type = TType;
+
+        static tag_type identity() {
+            return TType();
+        }
+
+        static tag_type compose(const tag_type &t_newer, const tag_type &t_older) {
+            return t_older + t_newer;
+        }
+
+        static TType apply(const TType &t_value, const tag_type &t_tag, std::size_t t_length) {
+            if constexpr (t_scale_by_length) {
+                return t_value + t_tag * static_cast<TType>(t_length);
+            } else {
+                return t_value + t_tag;
+            }
+        }
+    };
+
+    template<class TType, bool t_scale_by_length = false>
+    struct AssignAction {
+        using tag_type = std::optional<TType>;
+
+        static tag_type identity() {
+            return std::nullopt;
+        }
+
+        static tag_type compose(const tag_type &t_newer, const tag_type &t_older) {
+            return t_newer.has_value() ? t_newer : t_older;
+        }
+
+        static TType apply(const TType &t_value, const tag_type &t_tag, std::size_t t_length) {
+            if (!t_tag.has_value()) {
+                return t_value;
+            }
+            if constexpr (t_scale_by_length) {
+                return *t_tag * static_cast<TType>(t_length);
+            } else {
+                return *t_tag;
+            }
+        }
+    };
+
+    template<class TType, bool t_scale_by_length = false>
+    struct AffineAction {
+        using tag_type = std::pair<TType, TType>;
+
+        static tag_type identity() {
+            return {TType(1), TType()};
+        }
+
+        static tag_type compose(const tag_type &t_newer, const tag_type &t_older) {
+            return {t_newer.first * t_older.first, t_newer.first * t_older.second + t_newer.second};
+        }
+
+        static TType apply(const TType &t_value, const tag_type &t_tag, std::size_t t_length) {
+            if constexpr (t_scale_by_length) {
+                return t_tag.first * t_value + t_tag.second * static_cast<TType>(t_length);
+            } else {
+                return t_tag.first * t_value + t_tag.second;
+            }
+        }
+    };
+
+}
+
+#endif //COMPETITIVE_ALGORITHMS_LAZYACTION_H
@@ -0,0 +1,234 @@
+#ifndef COMPETITIVE_ALGORITHMS_LAZYSEGMENTTREE_H
+#define COMPETITIVE_ALGORITHMS_LAZYSEGMENTTREE_H
+
+#include <algorithm>
+#include <vector>
+#include "IMutableDataStructure.h"
+#include "ISegmentSolver.h"
+#include "LazyAction.h"
+
+namespace cpa {
+
+    template<class TType, class TFunction = std::function<TType(const TType &, const TType &)>,
+            class TAction = AddAction<TType>>
+    class LazySegmentTree :
+            public IMutableDataStructure<LazySegmentTree<TType, TFunction, TAction>, TType>,
+            public ISegmentSolver<LazySegmentTree<TType, TFunction, TAction>, TType, TFunction> {
+    public:
+        using tag_type = typename TAction::tag_type;
+
+    private:
+        std::vector<TType> m_nodes;
+        std::vector<tag_type> m_tags;
+
+        template<class TIter>
+        void build(TIter t_begin, TIter t_end);
+
+        void build(std::size_t t_node, std::size_t t_left, std::size_t t_right, const std::vector<TType> &t_data);
+
+        void applyToNode(std::size_t t_node, std::size_t t_left, std::size_t t_right, const tag_type &t_tag);
+
+        void push(std::size_t t_node, std::size_t t_left, std::size_t t_right);
+
+        void applyOnSegment(std::size_t t_node, std::size_t t_left, std::size_t t_right, std::size_t t_left_index,
+                            std::size_t t_right_index, const tag_type &t_tag);
+
+        void changeValueAt(std::size_t t_node, std::size_t t_left, std::size_t t_right, std::size_t t_index,
+                           const TType &t_value);
+
+        TType valueOnSegment(std::size_t t_node, std::size_t t_left, std::size_t t_right, std::size_t t_left_index,
+                             std::size_t t_right_index, const tag_type &t_pending) const;
+
+    public:
+        explicit LazySegmentTree(const TFunction &t_function = TFunction());
+
+        template<class TIter>
+        LazySegmentTree(TIter t_begin, TIter t_end, const TFunction &t_function = TFunction());
+
+        LazySegmentTree(const LazySegmentTree<TType, TFunction, TAction> &other);
+
+        LazySegmentTree(LazySegmentTree<TType, TFunction, TAction> &&other) noexcept;
+
+        TType getValueAt(std::size_t t_index) const;
+
+        void changeValueAt(std::size_t t_index, const TType &t_value);
+
+        void applyOnSegment(std::size_t t_left_index, std::size_t t_right_index, const tag_type &t_tag);
+
+        TType valueOnSegment(std::size_t t_left_index, std::size_t t_right_index) const;
+    };
+
+    template<class TType, class TFunction, class TAction>
+    LazySegmentTree<TType, TFunction, TAction>::LazySegmentTree(const TFunction &t_function) {
+        this->m_function = t_function;
+    }
+
+    template<class TType, class TFunction, class TAction>
+    template<class TIter>
+    LazySegmentTree<TType, TFunction, TAction>::LazySegmentTree(TIter t_begin, TIter t_end,
+                                                                const TFunction &t_function) {
+        this->m_function = t_function;
+        build(t_begin, t_end);
+    }
+
+    template<class TType, class TFunction, class TAction>
+    LazySegmentTree<TType, TFunction, TAction>::LazySegmentTree(
+            const LazySegmentTree<TType, TFunction, TAction> &other) {
+        this->m_function = other.m_function;
+        this->m_size = other.m_size;
+        this->m_nodes = other.m_nodes;
+        this->m_tags = other.m_tags;
+    }
+
+    template<class TType, class TFunction, class TAction>
+    LazySegmentTree<TType, TFunction, TAction>::LazySegmentTree(
+            LazySegmentTree<TType, TFunction, TAction> &&other) noexcept {
+        this->m_function = std::move(other.m_function);
+        this->m_size = std::move(other.m_size);
+        this->m_nodes = std::move(other.m_nodes);
+        this->m_tags = std::move(other.m_tags);
+    }
+
+    template<class TType, class TFunction, class TAction>
+    template<class TIter>
+    void LazySegmentTree<TType, TFunction, TAction>::build(TIter t_begin, TIter t_end) {
+        std::vector<TType> data(t_begin, t_end);
+        this->m_size = data.size();
+        if (this->m_size == 0) {
+            return;
+        }
+        this->m_nodes.resize(this->m_size * 4);
+        this->m_tags.assign(this->m_size * 4, TAction::identity());
+        build(1, 0, this->m_size - 1, data);
+    }
+
+    template<class TType, class TFunction, class TAction>
+    void LazySegmentTree<TType, TFunction, TAction>::build(std::size_t t_node, std::size_t t_left,
+                                                           std::size_t t_right, const std::vector<TType> &t_data) {
+        if (t_left == t_right) {
+            this->m_nodes[t_node] = t_data[t_left];
+            return;
+        }
+        auto middle = (t_left + t_right) / 2;
+        build(t_node * 2, t_left, middle, t_data);
+        build(t_node * 2 + 1, middle + 1, t_right, t_data);
+        this->m_nodes[t_node] = this->m_function(this->m_nodes[t_node * 2], this->m_nodes[t_node * 2 + 1]);
+    }
+
+    template<class TType, class TFunction, class TAction>
+    void LazySegmentTree<TType, TFunction, TAction>::applyToNode(std::size_t t_node, std::size_t t_left,
+                                                                 std::size_t t_right, const tag_type &t_tag) {
+        this->m_nodes[t_node] = TAction::apply(this->m_nodes[t_node], t_tag, t_right - t_left + 1);
+        if (t_left != t_right) {
+            this->m_tags[t_node] = TAction::compose(t_tag, this->m_tags[t_node]);
+        }
+    }
+
+    template<class TType, class TFunction, class TAction>
+    void LazySegmentTree<TType, TFunction, TAction>::push(std::size_t t_node, std::size_t t_left,
+                                                          std::size_t t_right) {
+        auto middle = (t_left + t_right) / 2;
+        applyToNode(t_node * 2, t_left, middle, this->m_tags[t_node]);
+        applyToNode(t_node * 2 + 1, middle + 1, t_right, this->m_tags[t_node]);
+        this->m_tags[t_node] = TAction::identity();
+    }
+
+    template<class TType, class TFunction, class TAction>
+    TType LazySegmentTree<TType, TFunction, TAction>::getValueAt(std::size_t t_index) const {
+        std::size_t node = 1, left = 0, right = this->m_size - 1;
+        auto pending = TAction::identity();
+        while (left != right) {
+            pending = TAction::compose(pending, this->m_tags[node]);
+            auto middle = (left + right) / 2;
+            if (t_index <= middle) {
+                node = node * 2;
+                right = middle;
+            } else {
+                node = node * 2 + 1;
+                left = middle + 1;
+            }
+        }
+        return TAction::apply(this->m_nodes[node], pending, 1);
+    }
+
+    template<class TType, class TFunction, class TAction>
+    void LazySegmentTree<TType, TFunction, TAction>::changeValueAt(std::size_t t_index, const TType &t_value) {
+        changeValueAt(1, 0, this->m_size - 1, t_index, t_value);
+    }
+
+    template<class TType, class TFunction, class TAction>
+    void LazySegmentTree<TType, TFunction, TAction>::changeValueAt(std::size_t t_node, std::size_t t_left,
+                                                                   std::size_t t_right, std::size_t t_index,
+                                                                   const TType &t_value) {
+        if (t_left == t_right) {
+            this->m_nodes[t_node] = t_value;
+            return;
+        }
+        push(t_node, t_left, t_right);
+        auto middle = (t_left + t_right) / 2;
+        if (t_index <= middle) {
+            changeValueAt(t_node * 2, t_left, middle, t_index, t_value);
+        } else {
+            changeValueAt(t_node * 2 + 1, middle + 1, t_right, t_index, t_value);
+        }
+        this->m_nodes[t_node] = this->m_function(this->m_nodes[t_node * 2], this->m_nodes[t_node * 2 + 1]);
+    }
+
+    template<class TType, class TFunction, class TAction>
+    void LazySegmentTree<TType, TFunction, TAction>::applyOnSegment(std::size_t t_left_index,
+                                                                    std::size_t t_right_index,
+                                                                    const tag_type &t_tag) {
+        applyOnSegment(1, 0, this->m_size - 1, t_left_index, t_right_index, t_tag);
+    }
+
+    template<class TType, class TFunction, class TAction>
+    void LazySegmentTree<TType, TFunction, TAction>::applyOnSegment(std::size_t t_node, std::size_t t_left,
+                                                                    std::size_t t_right, std::size_t t_left_index,
+                                                                    std::size_t t_right_index,
+                                                                    const tag_type &t_tag) {
+        if (t_left_index == t_left && t_right_index == t_right) {
+            applyToNode(t_node, t_left, t_right, t_tag);
+            return;
+        }
+        push(t_node, t_left, t_right);
+        auto middle = (t_left + t_right) / 2;
+        if (t_left_index <= middle) {
+            applyOnSegment(t_node * 2, t_left, middle, t_left_index, std::min(t_right_index, middle), t_tag);
+        }
+        if (t_right_index > middle) {
+            applyOnSegment(t_node * 2 + 1, middle + 1, t_right, std::max(t_left_index, middle + 1), t_right_index,
+                           t_tag);
+        }
+        this->m_nodes[t_node] = this->m_function(this->m_nodes[t_node * 2], this->m_nodes[t_node * 2 + 1]);
+    }
+
+    template<class TType, class TFunction, class TAction>
+    TType LazySegmentTree<TType, TFunction, TAction>::valueOnSegment(std::size_t t_left_index,
+                                                                     std::size_t t_right_index) const {
+        return valueOnSegment(1, 0, this->m_size - 1, t_left_index, t_right_index, TAction::identity());
+    }
+
+    template<class TType, class TFunction, class TAction>
+    TType LazySegmentTree<TType, TFunction, TAction>::valueOnSegment(std::size_t t_node, std::size_t t_left,
+                                                                     std::size_t t_right, std::size_t t_left_index,
+                                                                     std::size_t t_right_index,
+                                                                     const tag_type &t_pending) const {
+        if (t_left_index == t_left && t_right_index == t_right) {
+            return TAction::apply(this->m_nodes[t_node], t_pending, t_right - t_left + 1);
+        }
+        auto pending = TAction::compose(t_pending, this->m_tags[t_node]);
+        auto middle = (t_left + t_right) / 2;
+        if (t_right_index <= middle) {
+            return valueOnSegment(t_node * 2, t_left, middle, t_left_index, t_right_index, pending);
+        }
+        if (t_left_index > middle) {
+            return valueOnSegment(t_node * 2 + 1, middle + 1, t_right, t_left_index, t_right_index, pending);
+        }
+        return this->m_function(valueOnSegment(t_node * 2, t_left, middle, t_left_index, middle, pending),
+                                valueOnSegment(t_node * 2 + 1, middle + 1, t_right, middle + 1, t_right_index,
+                                               pending));
+    }
+
+}
+
+#endif //COMPETITIVE_ALGORITHMS_LAZYSEGMENTTREE_H
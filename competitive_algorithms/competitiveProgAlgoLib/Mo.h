@@ -0,0 +1,130 @@
+#ifndef COMPETITIVE_ALGORITHMS_MO_H
+#define COMPETITIVE_ALGORITHMS_MO_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include "Intrinsics.h"
+
+namespace cpa {
+
+    inline std::uint64_t hilbertOrder(std::uint64_t t_x, std::uint64_t t_y, std::size_t t_power) noexcept {
+        auto side = std::uint64_t{1} << t_power;
+        std::uint64_t result = 0;
+        for (auto s = side >> 1u; s > 0; s >>= 1u) {
+            std::uint64_t rx = (t_x & s) != 0;
+            std::uint64_t ry = (t_y & s) != 0;
+            result += s * s * ((3 * rx) ^ ry);
+            if (ry == 0) {
+                if (rx == 1) {
+                    t_x = side - 1 - t_x;
+                    t_y = side - 1 - t_y;
+                }
+                std::swap(t_x, t_y);
+            }
+        }
+        return result;
+    }
+
+    namespace detail {
+
+        template<class TAdd, class TRemove>
+        void moveWindow(std::size_t &t_current_left, std::size_t &t_current_right, std::size_t t_left,
+                        std::size_t t_right, const TAdd &t_add, const TRemove &t_remove) {
+            while (t_current_left > t_left) {
+                t_add(--t_current_left);
+            }
+            while (t_current_right < t_right) {
+                t_add(t_current_right++);
+            }
+            while (t_current_left < t_left) {
+                t_remove(t_current_left++);
+            }
+            while (t_current_right > t_right) {
+                t_remove(--t_current_right);
+            }
+        }
+
+    }
+
+    template<class TAdd, class TRemove, class TAnswer>
+    void solveMo(const std::vector<std::pair<std::size_t, std::size_t>> &t_queries,
+                 const TAdd &t_add, const TRemove &t_remove, const TAnswer &t_answer) {
+        std::size_t max_index = 0;
+        for (auto &[l, r] : t_queries) {
+            max_index = std::max(max_index, r);
+        }
+        auto power = std::max<std::size_t>(1, bitWidth(max_index));
+        std::vector<std::uint64_t> keys(t_queries.size());
+        for (std::size_t i = 0; i < t_queries.size(); ++i) {
+            keys[i] = hilbertOrder(t_queries[i].first, t_queries[i].second, power);
+        }
+        std::vector<std::size_t> order(t_queries.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&keys](std::size_t a, std::size_t b) {
+            return keys[a] < keys[b];
+        });
+        std::size_t current_left = 0, current_right = 0;
+        for (auto query : order) {
+            detail::moveWindow(current_left, current_right, t_queries[query].first, t_queries[query].second + 1,
+                               t_add, t_remove);
+            t_answer(query);
+        }
+    }
+
+    template<class TAdd, class TRemove, class TToggle, class TAnswer>
+    void solveMoWithUpdates(const std::vector<std::tuple<std::size_t, std::size_t, std::size_t>> &t_queries,
+                            const std::vector<std::size_t> &t_update_positions, const TAdd &t_add,
+                            const TRemove &t_remove, const TToggle &t_toggle, const TAnswer &t_answer) {
+        std::size_t max_index = 0;
+        for (auto &query : t_queries) {
+            max_index = std::max(max_index, std::get<1>(query));
+        }
+        auto block_size = std::max<std::size_t>(
+                1, static_cast<std::size_t>(std::cbrt(static_cast<double>(max_index + 1) * (max_index + 1))));
+        std::vector<std::size_t> order(t_queries.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+            auto a_left = std::get<0>(t_queries[a]) / block_size, b_left = std::get<0>(t_queries[b]) / block_size;
+            if (a_left != b_left) {
+                return a_left < b_left;
+            }
+            auto a_right = std::get<1>(t_queries[a]) / block_size, b_right = std::get<1>(t_queries[b]) / block_size;
+            if (a_right != b_right) {
+                return (a_left & 1u) == 0 ? a_right < b_right : a_right > b_right;
+            }
+            return (a_right & 1u) == 0 ? std::get<2>(t_queries[a]) < std::get<2>(t_queries[b]) :
+                   std::get<2>(t_queries[a]) > std::get<2>(t_queries[b]);
+        });
+        std::size_t current_left = 0, current_right = 0, current_time = 0;
+        auto apply = [&](std::size_t t_update) {
+            auto position = t_update_positions[t_update];
+            auto inside = current_left <= position && position < current_right;
+            if (inside) {
+                t_remove(position);
+            }
+            t_toggle(t_update);
+            if (inside) {
+                t_add(position);
+            }
+        };
+        for (auto query : order) {
+            auto &[left, right, time] = t_queries[query];
+            detail::moveWindow(current_left, current_right, left, right + 1, t_add, t_remove);
+            while (current_time < time) {
+                apply(current_time++);
+            }
+            while (current_time > time) {
+                apply(--current_time);
+            }
+            t_answer(query);
+        }
+    }
+
+}
+
+#endif //COMPETITIVE_ALGORITHMS_MO_H
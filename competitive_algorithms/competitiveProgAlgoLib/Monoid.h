@@ -0,0 +1,144 @@
+#ifndef COMPETITIVE_ALGORITHMS_MONOID_H
+#define COMPETITIVE_ALGORITHMS_MONOID_H
+
+#include <limits>
+#include <numeric>
+#include <type_traits>
+
+namespace cpa {
+
+    template<class TType>
+    struct Min {
+        static constexpr bool idempotent = true;
+        static constexpr bool commutative = true;
+        static constexpr bool invertible = false;
+
+        static constexpr TType identity() noexcept {
+            return std::numeric_limits<TType>::max();
+        }
+
+        constexpr TType operator()(const TType &a, const TType &b) const {
+            return b < a ? b : a;
+        }
+    };
+
+    template<class TType>
+    struct Max {
+        static constexpr bool idempotent = true;
+        static constexpr bool commutative = true;
+        static constexpr bool invertible = false;
+
+        static constexpr TType identity() noexcept {
+            return std::numeric_limits<TType>::lowest();
+        }
+
+        constexpr TType operator()(const TType &a, const TType &b) const {
+            return a < b ? b : a;
+        }
+    };
+
+    template<class TType>
+    struct Sum {
+        static constexpr bool idempotent = false;
+        static constexpr bool commutative = true;
+        static constexpr bool invertible = true;
+
+        static constexpr TType identity() noexcept {
+            return TType();
+        }
+
+        static constexpr TType inverse(const TType &a) {
+            return -a;
+        }
+
+        constexpr TType operator()(const TType &a, const TType &b) const {
+            return a + b;
+        }
+    };
+
+    template<class TType>
+    struct Xor {
+        static constexpr bool idempotent = false;
+        static constexpr bool commutative = true;
+        static constexpr bool invertible = true;
+
+        static constexpr TType identity() noexcept {
+            return TType();
+        }
+
+        static constexpr TType inverse(const TType &a) {
+            return a;
+        }
+
+        constexpr TType operator()(const TType &a, const TType &b) const {
+            return a ^ b;
+        }
+    };
+
+    template<class TType>
+    struct Gcd {
+        static constexpr bool idempotent = true;
+        static constexpr bool commutative = true;
+        static constexpr bool invertible = false;
+
+        static constexpr TType identity() noexcept {
+            return TType();
+        }
+
+        constexpr TType operator()(const TType &a, const TType &b) const {
+            return std::gcd(a, b);
+        }
+    };
+
+    template<class TType>
+    struct And {
+        static constexpr bool idempotent = true;
+        static constexpr bool commutative = true;
+        static constexpr bool invertible = false;
+
+        static constexpr TType identity() noexcept {
+            return ~TType();
+        }
+
+        constexpr TType operator()(const TType &a, const TType &b) const {
+            return a & b;
+        }
+    };
+
+    template<class TType>
+    struct Or {
+        static constexpr bool idempotent = true;
+        static constexpr bool commutative = true;
+        static constexpr bool invertible = false;
+
+        static constexpr TType identity() noexcept {
+            return TType();
+        }
+
+        constexpr TType operator()(const TType &a, const TType &b) const {
+            return a | b;
+        }
+    };
+
+    template<class TFunction, class = void>
+    struct MonoidTraits {
+        static constexpr bool is_monoid = false;
+        static constexpr bool idempotent = false;
+        static constexpr bool commutative = false;
+        static constexpr bool invertible = false;
+    };
+
+    template<class TFunction>
+    struct MonoidTraits<TFunction, std::void_t<decltype(TFunction::identity())>> {
+        static constexpr bool is_monoid = true;
+        static constexpr bool idempotent = TFunction::idempotent;
+        static constexpr bool commutative = TFunction::commutative;
+        static constexpr bool invertible = TFunction::invertible;
+    };
+
+    template<class TFunction>
+    inline constexpr bool is_monoid_v = MonoidTraits<TFunction>::is_monoid;
+
+}
+
+#endif //COMPETITIVE_ALGORITHMS_MONOID_H
@@ -0,0 +1,74 @@
+#ifndef COMPETITIVE_ALGORITHMS_PARALLEL_H
+#define COMPETITIVE_ALGORITHMS_PARALLEL_H
+
+#include <algorithm>
+#include <cstdlib>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace cpa {
+
+    inline std::size_t resolveThreadCount(std::size_t t_thread_count) noexcept {
+        if (t_thread_count == 0) {
+            return std::max<std::size_t>(1, std::thread::hardware_concurrency());
+        }
+        return t_thread_count;
+    }
+
+    template<class TFunction>
+    void parallelFor(std::size_t t_begin, std::size_t t_end, std::size_t t_thread_count,
+                     const TFunction &t_function) {
+        constexpr std::size_t min_chunk_size = 1u << 14u;
+        if (t_end <= t_begin) {
+            return;
+        }
+        auto length = t_end - t_begin;
+        auto thread_count = std::min(t_thread_count, (length + min_chunk_size - 1) / min_chunk_size);
+        if (thread_count <= 1) {
+            for (auto i = t_begin; i < t_end; ++i) {
+                t_function(i);
+            }
+            return;
+        }
+        auto chunk_size = (length + thread_count - 1) / thread_count;
+        std::vector<std::exception_ptr> errors(thread_count - 1);
+        {
+            struct joiner {
+                std::vector<std::thread> &m_workers;
+
+                ~joiner() {
+                    for (auto &worker : m_workers) {
+                        worker.join();
+                    }
+                }
+            };
+            std::vector<std::thread> workers;
+            joiner guard{workers};
+            workers.reserve(thread_count - 1);
+            for (auto from = t_begin + chunk_size; from < t_end; from += chunk_size) {
+                auto to = std::min(from + chunk_size, t_end);
+                workers.emplace_back([&t_function, &error = errors[workers.size()], from, to]() {
+                    try {
+                        for (auto i = from; i < to; ++i) {
+                            t_function(i);
+                        }
+                    } catch (...) {
+                        error = std::current_exception();
+                    }
+                });
+            }
+            for (auto i = t_begin; i < t_begin + chunk_size; ++i) {
+                t_function(i);
+            }
+        }
+        for (auto &error : errors) {
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+    }
+
+}
+
+#endif //COMPETITIVE_ALGORITHMS_PARALLEL_H
@@ -0,0 +1,332 @@
+#ifndef COMPETITIVE_ALGORITHMS_PERSISTENTSEGMENTTREE_H
+#define COMPETITIVE_ALGORITHMS_PERSISTENTSEGMENTTREE_H
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "Arena.h"
+#include "IMutableDataStructure.h"
+#include "ISegmentSolver.h"
+
+namespace cpa {
+
+    template<class TType, class TFunction = std::function<TType(const TType &, const TType &)>>
+    class PersistentSegmentTree :
+            public IMutableDataStructure<PersistentSegmentTree<TType, TFunction>, TType>,
+            public ISegmentSolver<PersistentSegmentTree<TType, TFunction>, TType, TFunction> {
+    private:
+        using index_type = std::uint32_t;
+
+        static constexpr index_type null_node = std::numeric_limits<index_type>::max();
+
+        struct node {
+            index_type left;
+            index_type right;
+            TType value;
+        };
+
+        // A single writer may call changeValueAt while readers query versions it has already returned;
+        // eraseVersion and collectGarbage need exclusive access.
+        Arena<node> m_nodes;
+        Arena<index_type> m_versions;
+        std::atomic<std::size_t> m_version_count{0};
+
+        index_type root(std::size_t t_version) const;
+
+        std::size_t publish(index_type t_root);
+
+        index_type allocate(const node &t_node);
+
+        template<class TIter>
+        index_type build(TIter &t_iter, std::size_t t_left, std::size_t t_right);
+
+        index_type update(index_type t_node, std::size_t t_left, std::size_t t_right,
+                          std::size_t t_index, const TType &t_value);
+
+        TType query(index_type t_node, std::size_t t_left, std::size_t t_right,
+                    std::size_t t_left_index, std::size_t t_right_index) const;
+
+    public:
+        explicit PersistentSegmentTree(const TFunction &t_function = TFunction());
+
+        template<class TIter>
+        PersistentSegmentTree(TIter t_begin, TIter t_end, const TFunction &t_function = TFunction());
+
+        PersistentSegmentTree(const PersistentSegmentTree<TType, TFunction> &other);
+
+        PersistentSegmentTree(PersistentSegmentTree<TType, TFunction> &&other) noexcept;
+
+        [[nodiscard]]
+        std::size_t versionCount() const noexcept;
+
+        [[nodiscard]]
+        std::size_t latestVersion() const;
+
+        [[nodiscard]]
+        std::size_t nodeCount() const noexcept;
+
+        const TType &getValueAt(std::size_t t_index) const;
+
+        const TType &getValueAt(std::size_t t_version, std::size_t t_index) const;
+
+        void changeValueAt(std::size_t t_index, const TType &t_value);
+
+        std::size_t changeValueAt(std::size_t t_version, std::size_t t_index, const TType &t_value);
+
+        TType valueOnSegment(std::size_t t_left_index, std::size_t t_right_index) const;
+
+        TType valueOnSegment(std::size_t t_version, std::size_t t_left_index, std::size_t t_right_index) const;
+
+        void eraseVersion(std::size_t t_version);
+
+        void collectGarbage();
+    };
+
+    template<class TType, class TFunction>
+    PersistentSegmentTree<TType, TFunction>::PersistentSegmentTree(const TFunction &t_function) {
+        this->m_function = t_function;
+    }
+
+    template<class TType, class TFunction>
+    template<class TIter>
+    PersistentSegmentTree<TType, TFunction>::PersistentSegmentTree(TIter t_begin, TIter t_end,
+                                                                   const TFunction &t_function) {
+        this->m_function = t_function;
+        this->m_size = std::distance(t_begin, t_end);
+        if (this->m_size == 0) {
+            return;
+        }
+        publish(build(t_begin, 0, this->m_size - 1));
+    }
+
+    template<class TType, class TFunction>
+    PersistentSegmentTree<TType, TFunction>::PersistentSegmentTree(
+            const PersistentSegmentTree<TType, TFunction> &other) {
+        this->m_function = other.m_function;
+        this->m_size = other.m_size;
+        this->m_nodes = other.m_nodes;
+        this->m_versions = other.m_versions;
+        this->m_version_count.store(other.versionCount(), std::memory_order_relaxed);
+    }
+
+    template<class TType, class TFunction>
+    PersistentSegmentTree<TType, TFunction>::PersistentSegmentTree(
+            PersistentSegmentTree<TType, TFunction> &&other) noexcept {
+        this->m_function = std::move(other.m_function);
+        this->m_size = std::move(other.m_size);
+        this->m_nodes = std::move(other.m_nodes);
+        this->m_versions = std::move(other.m_versions);
+        this->m_version_count.store(other.m_version_count.exchange(0, std::memory_order_relaxed),
+                                    std::memory_order_relaxed);
+    }
+
+    template<class TType, class TFunction>
+    typename PersistentSegmentTree<TType, TFunction>::index_type
+    PersistentSegmentTree<TType, TFunction>::root(std::size_t t_version) const {
+        if (t_version >= versionCount() || this->m_versions[t_version] == null_node) {
+            throw std::out_of_range("erased or unknown version " + std::to_string(t_version));
+        }
+        return this->m_versions[t_version];
+    }
+
+    template<class TType, class TFunction>
+    std::size_t PersistentSegmentTree<TType, TFunction>::publish(index_type t_root) {
+        this->m_versions.push_back(t_root);
+        this->m_version_count.store(this->m_versions.size(), std::memory_order_release);
+        return this->m_versions.size() - 1;
+    }
+
+    template<class TType, class TFunction>
+    typename PersistentSegmentTree<TType, TFunction>::index_type
+    PersistentSegmentTree<TType, TFunction>::allocate(const node &t_node) {
+        if (this->m_nodes.size() >= null_node) {
+            throw std::length_error("PersistentSegmentTree node index overflow");
+        }
+        this->m_nodes.push_back(t_node);
+        return static_cast<index_type>(this->m_nodes.size() - 1);
+    }
+
+    template<class TType, class TFunction>
+    template<class TIter>
+    typename PersistentSegmentTree<TType, TFunction>::index_type
+    PersistentSegmentTree<TType, TFunction>::build(TIter &t_iter, std::size_t t_left, std::size_t t_right) {
+        if (t_left == t_right) {
+            auto leaf = allocate(node{null_node, null_node, *t_iter});
+            ++t_iter;
+            return leaf;
+        }
+        auto middle = (t_left + t_right) >> 1u;
+        auto left = build(t_iter, t_left, middle);
+        auto right = build(t_iter, middle + 1, t_right);
+        return allocate(node{left, right, this->m_function(this->m_nodes[left].value,
+                                                           this->m_nodes[right].value)});
+    }
+
+    template<class TType, class TFunction>
+    typename PersistentSegmentTree<TType, TFunction>::index_type
+    PersistentSegmentTree<TType, TFunction>::update(index_type t_node, std::size_t t_left, std::size_t t_right,
+                                                    std::size_t t_index, const TType &t_value) {
+        if (t_left == t_right) {
+            return allocate(node{null_node, null_node, t_value});
+        }
+        auto middle = (t_left + t_right) >> 1u;
+        auto left = this->m_nodes[t_node].left;
+        auto right = this->m_nodes[t_node].right;
+        if (t_index <= middle) {
+            left = update(left, t_left, middle, t_index, t_value);
+        } else {
+            right = update(right, middle + 1, t_right, t_index, t_value);
+        }
+        return allocate(node{left, right, this->m_function(this->m_nodes[left].value,
+                                                           this->m_nodes[right].value)});
+    }
+
+    template<class TType, class TFunction>
+    TType PersistentSegmentTree<TType, TFunction>::query(index_type t_node, std::size_t t_left, std::size_t t_right,
+                                                         std::size_t t_left_index,
+                                                         std::size_t t_right_index) const {
+        while (true) {
+            if (t_left_index == t_left && t_right_index == t_right) {
+                return this->m_nodes[t_node].value;
+            }
+            auto middle = (t_left + t_right) >> 1u;
+            if (t_right_index <= middle) {
+                t_node = this->m_nodes[t_node].left;
+                t_right = middle;
+            } else if (t_left_index > middle) {
+                t_node = this->m_nodes[t_node].right;
+                t_left = middle + 1;
+            } else {
+                return this->m_function(query(this->m_nodes[t_node].left, t_left, middle, t_left_index, middle),
+                                        query(this->m_nodes[t_node].right, middle + 1, t_right,
+                                              middle + 1, t_right_index));
+            }
+        }
+    }
+
+    template<class TType, class TFunction>
+    std::size_t PersistentSegmentTree<TType, TFunction>::versionCount() const noexcept {
+        return this->m_version_count.load(std::memory_order_acquire);
+    }
+
+    template<class TType, class TFunction>
+    std::size_t PersistentSegmentTree<TType, TFunction>::latestVersion() const {
+        for (auto version = versionCount(); version > 0; --version) {
+            if (this->m_versions[version - 1] != null_node) {
+                return version - 1;
+            }
+        }
+        throw std::out_of_range("no live version");
+    }
+
+    template<class TType, class TFunction>
+    std::size_t PersistentSegmentTree<TType, TFunction>::nodeCount() const noexcept {
+        return this->m_nodes.size();
+    }
+
+    template<class TType, class TFunction>
+    const TType &PersistentSegmentTree<TType, TFunction>::getValueAt(std::size_t t_index) const {
+        return getValueAt(latestVersion(), t_index);
+    }
+
+    template<class TType, class TFunction>
+    const TType &PersistentSegmentTree<TType, TFunction>::getValueAt(std::size_t t_version,
+                                                                     std::size_t t_index) const {
+        auto current = root(t_version);
+        std::size_t left = 0, right = this->m_size - 1;
+        while (left != right) {
+            auto middle = (left + right) >> 1u;
+            if (t_index <= middle) {
+                current = this->m_nodes[current].left;
+                right = middle;
+            } else {
+                current = this->m_nodes[current].right;
+                left = middle + 1;
+            }
+        }
+        return this->m_nodes[current].value;
+    }
+
+    template<class TType, class TFunction>
+    void PersistentSegmentTree<TType, TFunction>::changeValueAt(std::size_t t_index, const TType &t_value) {
+        changeValueAt(latestVersion(), t_index, t_value);
+    }
+
+    template<class TType, class TFunction>
+    std::size_t PersistentSegmentTree<TType, TFunction>::changeValueAt(std::size_t t_version, std::size_t t_index,
+                                                                       const TType &t_value) {
+        return publish(update(root(t_version), 0, this->m_size - 1, t_index, t_value));
+    }
+
+    template<class TType, class TFunction>
+    TType PersistentSegmentTree<TType, TFunction>::valueOnSegment(std::size_t t_left_index,
+                                                                  std::size_t t_right_index) const {
+        return valueOnSegment(latestVersion(), t_left_index, t_right_index);
+    }
+
+    template<class TType, class TFunction>
+    TType PersistentSegmentTree<TType, TFunction>::valueOnSegment(std::size_t t_version, std::size_t t_left_index,
+                                                                  std::size_t t_right_index) const {
+        return query(root(t_version), 0, this->m_size - 1, t_left_index, t_right_index);
+    }
+
+    template<class TType, class TFunction>
+    void PersistentSegmentTree<TType, TFunction>::eraseVersion(std::size_t t_version) {
+        if (t_version >= versionCount()) {
+            throw std::out_of_range("unknown version " + std::to_string(t_version));
+        }
+        this->m_versions[t_version] = null_node;
+    }
+
+    template<class TType, class TFunction>
+    void PersistentSegmentTree<TType, TFunction>::collectGarbage() {
+        std::vector<index_type> remap(this->m_nodes.size(), null_node);
+        std::vector<index_type> st;
+        for (std::size_t i = 0; i < this->m_versions.size(); ++i) {
+            auto current = this->m_versions[i];
+            if (current != null_node && remap[current] == null_node) {
+                remap[current] = 0;
+                st.push_back(current);
+            }
+        }
+        while (!st.empty()) {
+            auto &current = this->m_nodes[st.back()];
+            st.pop_back();
+            for (auto child : {current.left, current.right}) {
+                if (child != null_node && remap[child] == null_node) {
+                    remap[child] = 0;
+                    st.push_back(child);
+                }
+            }
+        }
+        index_type next = 0;
+        for (std::size_t i = 0; i < this->m_nodes.size(); ++i) {
+            if (remap[i] == null_node) {
+                continue;
+            }
+            remap[i] = next;
+            auto &current = this->m_nodes[i];
+            if (current.left != null_node) {
+                current.left = remap[current.left];
+                current.right = remap[current.right];
+            }
+            if (next != i) {
+                this->m_nodes[next] = std::move(current);
+            }
+            ++next;
+        }
+        this->m_nodes.truncate(next);
+        for (std::size_t i = 0; i < this->m_versions.size(); ++i) {
+            auto &current = this->m_versions[i];
+            if (current != null_node) {
+                current = remap[current];
+            }
+        }
+    }
+
+}
+
+#endif //COMPETITIVE_ALGORITHMS_PERSISTENTSEGMENTTREE_H
@@ -0,0 +1,129 @@
+#ifndef COMPETITIVE_ALGORITHMS_RANGEFENWICKTREE_H
+#define COMPETITIVE_ALGORITHMS_RANGEFENWICKTREE_H
+
+#include <vector>
+#include "ISegmentSolver.h"
+
+namespace cpa {
+
+    template<class TType>
+    class RangeFenwickTree : public ISegmentSolver<RangeFenwickTree<TType>, TType, Sum<TType>> {
+    private:
+        std::size_t m_size{};
+        std::vector<TType> m_linear_tree;
+        std::vector<TType> m_constant_tree;
+
+        void add(std::vector<TType> &t_tree, std::size_t t_position, const TType &t_delta);
+
+        TType sum(const std::vector<TType> &t_tree, std::size_t t_position) const;
+
+    public:
+        explicit RangeFenwickTree(std::size_t t_size = 0);
+
+        template<class TIter>
+        RangeFenwickTree(TIter t_begin, TIter t_end);
+
+        RangeFenwickTree(const RangeFenwickTree<TType> &other);
+
+        RangeFenwickTree(RangeFenwickTree<TType> &&other) noexcept;
+
+        [[nodiscard]] std::size_t size() const noexcept;
+
+        TType getValueAt(std::size_t t_index) const;
+
+        void addOnSegment(std::size_t t_left_index, std::size_t t_right_index, const TType &t_delta);
+
+        TType prefix(std::size_t t_index) const;
+
+        TType valueOnSegment(std::size_t t_left_index, std::size_t t_right_index) const;
+    };
+
+    template<class TType>
+    RangeFenwickTree<TType>::RangeFenwickTree(std::size_t t_size) {
+        this->m_size = t_size;
+        this->m_linear_tree.assign(t_size + 1, TType());
+        this->m_constant_tree.assign(t_size + 1, TType());
+    }
+
+    template<class TType>
+    template<class TIter>
+    RangeFenwickTree<TType>::RangeFenwickTree(TIter t_begin, TIter t_end) {
+        this->m_size = std::distance(t_begin, t_end);
+        this->m_linear_tree.assign(this->m_size + 1, TType());
+        this->m_constant_tree.assign(this->m_size + 1, TType());
+        std::size_t i = 1;
+        for (auto it = t_begin; it != t_end; ++it, ++i) {
+            this->m_constant_tree[i] = this->m_constant_tree[i] - *it;
+            auto parent = i + (i & (~i + 1));
+            if (parent <= this->m_size) {
+                this->m_constant_tree[parent] = this->m_constant_tree[parent] + this->m_constant_tree[i];
+            }
+        }
+    }
+
+    template<class TType>
+    RangeFenwickTree<TType>::RangeFenwickTree(const RangeFenwickTree<TType> &other) {
+        this->m_size = other.m_size;
+        this->m_linear_tree = other.m_linear_tree;
+        this->m_constant_tree = other.m_constant_tree;
+    }
+
+    template<class TType>
+    RangeFenwickTree<TType>::RangeFenwickTree(RangeFenwickTree<TType> &&other) noexcept {
+        this->m_size = std::move(other.m_size);
+        this->m_linear_tree = std::move(other.m_linear_tree);
+        this->m_constant_tree = std::move(other.m_constant_tree);
+    }
+
+    template<class TType>
+    std::size_t RangeFenwickTree<TType>::size() const noexcept {
+        return this->m_size;
+    }
+
+    template<class TType>
+    void RangeFenwickTree<TType>::add(std::vector<TType> &t_tree, std::size_t t_position, const TType &t_delta) {
+        for (; t_position <= this->m_size; t_position += t_position & (~t_position + 1)) {
+            t_tree[t_position] = t_tree[t_position] + t_delta;
+        }
+    }
+
+    template<class TType>
+    TType RangeFenwickTree<TType>::sum(const std::vector<TType> &t_tree, std::size_t t_position) const {
+        TType result = TType();
+        for (; t_position > 0; t_position &= t_position - 1) {
+            result = result + t_tree[t_position];
+        }
+        return result;
+    }
+
+    template<class TType>
+    TType RangeFenwickTree<TType>::getValueAt(std::size_t t_index) const {
+        return valueOnSegment(t_index, t_index);
+    }
+
+    template<class TType>
+    void RangeFenwickTree<TType>::addOnSegment(std::size_t t_left_index, std::size_t t_right_index,
+                                               const TType &t_delta) {
+        add(this->m_linear_tree, t_left_index + 1, t_delta);
+        add(this->m_linear_tree, t_right_index + 2, -t_delta);
+        add(this->m_constant_tree, t_left_index + 1, t_delta * static_cast<TType>(t_left_index));
+        add(this->m_constant_tree, t_right_index + 2, -t_delta * static_cast<TType>(t_right_index + 1));
+    }
+
+    template<class TType>
+    TType RangeFenwickTree<TType>::prefix(std::size_t t_index) const {
+        return sum(this->m_linear_tree, t_index + 1) * static_cast<TType>(t_index + 1) -
+               sum(this->m_constant_tree, t_index + 1);
+    }
+
+    template<class TType>
+    TType RangeFenwickTree<TType>::valueOnSegment(std::size_t t_left_index, std::size_t t_right_index) const {
+        if (t_left_index == 0) {
+            return prefix(t_right_index);
+        }
+        return prefix(t_right_index) - prefix(t_left_index - 1);
+    }
+
+}
+
+#endif //COMPETITIVE_ALGORITHMS_RANGEFENWICKTREE_H
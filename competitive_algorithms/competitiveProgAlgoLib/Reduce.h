@@ -0,0 +1,114 @@
+#ifndef COMPETITIVE_ALGORITHMS_REDUCE_H
+#define COMPETITIVE_ALGORITHMS_REDUCE_H
+
+#include <cstdlib>
+#include <type_traits>
+#include "Monoid.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define CPA_REDUCE_DISPATCH
+#define CPA_ALWAYS_INLINE inline __attribute__((always_inline))
+#else
+#define CPA_ALWAYS_INLINE inline
+#endif
+
+namespace cpa {
+
+    template<class TType, class TFunction>
+    struct is_vectorizable_reduction : std::bool_constant<
+            std::is_arithmetic_v<TType> && (
+                    std::is_same_v<TFunction, Min<TType>> ||
+                    std::is_same_v<TFunction, Max<TType>> ||
+                    (std::is_integral_v<TType> && (
+                            std::is_same_v<TFunction, Sum<TType>> ||
+                            std::is_same_v<TFunction, Xor<TType>> ||
+                            std::is_same_v<TFunction, And<TType>> ||
+                            std::is_same_v<TFunction, Or<TType>>)))> {
+    };
+
+    template<class TType, class TFunction>
+    inline constexpr bool is_vectorizable_reduction_v = is_vectorizable_reduction<TType, TFunction>::value;
+
+    namespace detail {
+
+        template<std::size_t t_lanes, class TType, class TFunction>
+        CPA_ALWAYS_INLINE TType reduceLanes(const TType *t_first, const TType *t_last, TType t_init,
+                                            const TFunction &t_function) {
+            if (static_cast<std::size_t>(t_last - t_first) >= t_lanes * 2) {
+                TType lanes[t_lanes];
+                for (std::size_t j = 0; j < t_lanes; ++j) {
+                    lanes[j] = t_first[j];
+                }
+                for (t_first += t_lanes; static_cast<std::size_t>(t_last - t_first) >= t_lanes; t_first += t_lanes) {
+                    for (std::size_t j = 0; j < t_lanes; ++j) {
+                        lanes[j] = t_function(lanes[j], t_first[j]);
+                    }
+                }
+                for (std::size_t j = 0; j < t_lanes; ++j) {
+                    t_init = t_function(t_init, lanes[j]);
+                }
+            }
+            for (; t_first != t_last; ++t_first) {
+                t_init = t_function(t_init, *t_first);
+            }
+            return t_init;
+        }
+
+        template<class TType, class TFunction>
+        TType reduceBaseline(const TType *t_first, const TType *t_last, TType t_init, const TFunction &t_function) {
+            return reduceLanes<32 / sizeof(TType)>(t_first, t_last, t_init, t_function);
+        }
+
+#ifdef CPA_REDUCE_DISPATCH
+
+        template<class TType, class TFunction>
+        __attribute__((target("avx2")))
+        TType reduceAvx2(const TType *t_first, const TType *t_last, TType t_init, const TFunction &t_function) {
+            return reduceLanes<64 / sizeof(TType)>(t_first, t_last, t_init, t_function);
+        }
+
+        template<class TType, class TFunction>
+        __attribute__((target("avx512f,avx512bw")))
+        TType reduceAvx512(const TType *t_first, const TType *t_last, TType t_init, const TFunction &t_function) {
+            return reduceLanes<128 / sizeof(TType)>(t_first, t_last, t_init, t_function);
+        }
+
+#endif
+
+        template<class TType, class TFunction>
+        using reduce_kernel = TType (*)(const TType *, const TType *, TType, const TFunction &);
+
+        template<class TType, class TFunction>
+        reduce_kernel<TType, TFunction> selectReduceKernel() {
+#ifdef CPA_REDUCE_DISPATCH
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) {
+                return &reduceAvx512<TType, TFunction>;
+            }
+            if (__builtin_cpu_supports("avx2")) {
+                return &reduceAvx2<TType, TFunction>;
+            }
+#endif
+            return &reduceBaseline<TType, TFunction>;
+        }
+
+    }
+
+    template<class TType, class TFunction>
+    TType reduceSegment(const TType *t_first, const TType *t_last, TType t_init, const TFunction &t_function) {
+        constexpr std::size_t short_range = 16;
+        if constexpr (is_vectorizable_reduction_v<TType, TFunction>) {
+            if (static_cast<std::size_t>(t_last - t_first) > short_range) {
+                static const auto kernel = detail::selectReduceKernel<TType, TFunction>();
+                return kernel(t_first, t_last, t_init, t_function);
+            }
+        }
+        for (; t_first != t_last; ++t_first) {
+            t_init = t_function(t_init, *t_first);
+        }
+        return t_init;
+    }
+
+}
+
+#endif //COMPETITIVE_ALGORITHMS_REDUCE_H
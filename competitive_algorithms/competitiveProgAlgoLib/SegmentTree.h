@@ -1,36 +1,57 @@
 #ifndef COMPETITIVE_ALGORITHMS_SEGMENTTREE_H
 #define COMPETITIVE_ALGORITHMS_SEGMENTTREE_H
 
+#include <memory>
+#include <string>
 #include "IMutableDataStructure.h"
 #include "ISegmentSolver.h"
+#include "Intrinsics.h"
+#include "Parallel.h"
+#include "Snapshot.h"
 
 namespace cpa {
 
     template<class TType, class TFunction = std::function<TType(const TType &, const TType &)>>
     class SegmentTree :
-            public IMutableDataStructure<TType>,
-            public ISegmentSolver<TType, TFunction> {
+            public IMutableDataStructure<SegmentTree<TType, TFunction>, TType>,
+            public ISegmentSolver<SegmentTree<TType, TFunction>, TType, TFunction> {
     private:
         std::vector<TType> m_nodes;
+        TType *m_tree = nullptr;
+        std::shared_ptr<MappedFile> m_mapping;
 
         template<class TIter>
-        void build(TIter t_begin, TIter t_end);
+        void build(TIter t_begin, TIter t_end, std::size_t t_thread_count);
 
     public:
-        explicit SegmentTree(const TFunction &t_function = nullptr);
+        explicit SegmentTree(const TFunction &t_function = TFunction());
 
         template<class TIter>
-        SegmentTree(TIter t_begin, TIter t_end, const TFunction &t_function = nullptr);
+        SegmentTree(TIter t_begin, TIter t_end, const TFunction &t_function = TFunction(),
+                    std::size_t t_thread_count = 1);
 
         SegmentTree(const SegmentTree<TType, TFunction> &other);
 
         SegmentTree(SegmentTree<TType, TFunction> &&other) noexcept;
 
-        const TType &getValueAt(std::size_t t_index) const override;
+        void save(const std::string &t_path) const;
 
-        void changeValueAt(std::size_t t_index, const TType &t_value) override;
+        static SegmentTree<TType, TFunction> open(const std::string &t_path, const TFunction &t_function = TFunction());
 
-        TType valueOnSegment(std::size_t t_left_index, std::size_t t_right_index) const override;
+        const TType &getValueAt(std::size_t t_index) const;
+
+        void changeValueAt(std::size_t t_index, const TType &t_value);
+
+        TType valueOnSegment(std::size_t t_left_index, std::size_t t_right_index) const;
+
+        void valueOnSegments(const std::vector<std::pair<std::size_t, std::size_t>> &t_queries,
+                             std::vector<TType> &t_result) const;
+
+        template<class TPredicate>
+        std::size_t maxRight(std::size_t t_left_index, const TPredicate &t_predicate) const;
+
+        template<class TPredicate>
+        std::size_t minLeft(std::size_t t_right_index, const TPredicate &t_predicate) const;
     };
 
     template<class TType, class TFunction>
@@ -40,16 +61,18 @@ namespace cpa {
 
     template<class TType, class TFunction>
     template<class TIter>
-    SegmentTree<TType, TFunction>::SegmentTree(TIter t_begin, TIter t_end, const TFunction &t_function) {
+    SegmentTree<TType, TFunction>::SegmentTree(TIter t_begin, TIter t_end, const TFunction &t_function,
+                                               std::size_t t_thread_count) {
         this->m_function = t_function;
-        build(t_begin, t_end);
+        build(t_begin, t_end, resolveThreadCount(t_thread_count));
     }
 
     template<class TType, class TFunction>
     SegmentTree<TType, TFunction>::SegmentTree(const SegmentTree<TType, TFunction> &other) {
         this->m_function = other.m_function;
         this->m_size = other.m_size;
-        this->m_nodes = other.m_nodes;
+        this->m_nodes.assign(other.m_tree, other.m_tree + (other.m_tree == nullptr ? 0 : other.m_size * 2));
+        this->m_tree = this->m_nodes.data();
     }
 
     template<class TType, class TFunction>
@@ -57,32 +80,62 @@ namespace cpa {
         this->m_function = std::move(other.m_function);
         this->m_size = std::move(other.m_size);
         this->m_nodes = std::move(other.m_nodes);
+        this->m_mapping = std::move(other.m_mapping);
+        this->m_tree = other.m_tree;
+        other.m_tree = nullptr;
+    }
+
+    template<class TType, class TFunction>
+    void SegmentTree<TType, TFunction>::save(const std::string &t_path) const {
+        writeSnapshot(t_path, SnapshotKind::SegmentTree, this->m_size, 0, this->m_tree,
+                      this->m_tree == nullptr ? 0 : this->m_size * 2);
+    }
+
+    template<class TType, class TFunction>
+    SegmentTree<TType, TFunction> SegmentTree<TType, TFunction>::open(const std::string &t_path,
+                                                                      const TFunction &t_function) {
+        SnapshotHeader header{};
+        SegmentTree<TType, TFunction> result(t_function);
+        result.m_mapping = openSnapshot<TType>(t_path, SnapshotKind::SegmentTree, true, header);
+        if (header.size > header.data_count / 2 ||
+            header.data_count != (header.size == 0 ? 0 : header.size * 2)) {
+            throw std::runtime_error("snapshot layout mismatch " + t_path);
+        }
+        result.m_size = header.size;
+        result.m_tree = snapshotData<TType>(result.m_mapping, header);
+        return result;
     }
 
     template<class TType, class TFunction>
     template<class TIter>
-    void SegmentTree<TType, TFunction>::build(TIter t_begin, TIter t_end) {
+    void SegmentTree<TType, TFunction>::build(TIter t_begin, TIter t_end, std::size_t t_thread_count) {
         this->m_size = std::distance(t_begin, t_end);
         if (this->m_size == 0) {
             return;
         }
         this->m_nodes.resize(this->m_size * 2);
+        countRebuild(this->m_function, this->m_nodes);
         std::copy(t_begin, t_end, this->m_nodes.begin() + this->m_size);
-        for (auto i = this->m_size - 1; i > 0; --i) {
-            this->m_nodes[i] = this->m_function(this->m_nodes[i << 1u], this->m_nodes[(i << 1u) | 1u]);
+        for (auto level = bitWidth(this->m_size - 1); level > 0; --level) {
+            auto level_begin = std::size_t{1} << (level - 1);
+            auto level_end = std::min(level_begin << 1u, this->m_size);
+            parallelFor(level_begin, level_end, t_thread_count, [this](std::size_t i) {
+                this->m_nodes[i] = this->m_function(this->m_nodes[i << 1u], this->m_nodes[(i << 1u) | 1u]);
+            });
         }
+        this->m_tree = this->m_nodes.data();
     }
 
     template<class TType, class TFunction>
     const TType &SegmentTree<TType, TFunction>::getValueAt(std::size_t t_index) const {
-        return this->m_nodes[this->m_size + t_index];
+        return this->m_tree[this->m_size + t_index];
     }
 
     template<class TType, class TFunction>
     void SegmentTree<TType, TFunction>::changeValueAt(std::size_t t_index, const TType &t_value) {
         t_index += this->m_size;
-        for (this->m_nodes[t_index] = t_value; t_index > 1; t_index >>= 1u) {
-            this->m_nodes[t_index >> 1u] = this->m_function(this->m_nodes[t_index], this->m_nodes[t_index ^ 1u]);
+        for (this->m_tree[t_index] = t_value; t_index > 1; t_index >>= 1u) {
+            this->m_tree[t_index >> 1u] = this->m_function(this->m_tree[t_index], this->m_tree[t_index ^ 1u]);
         }
     }
 
@@ -96,18 +149,18 @@ namespace cpa {
         }
         auto odd_left = (t_left_index & 1u) == 1;
         auto odd_right = (t_right_index & 1u) == 1;
-        auto result = odd_left ? this->m_nodes[t_left_index++] : this->m_nodes[--t_right_index];
+        auto result = odd_left ? this->m_tree[t_left_index++] : this->m_tree[--t_right_index];
         if (odd_left && odd_right) {
-            result = this->m_function(result, this->m_nodes[--t_right_index]);
+            result = this->m_function(result, this->m_tree[--t_right_index]);
         }
         t_left_index >>= 1u;
         t_right_index >>= 1u;
         while (t_left_index < t_right_index) {
             if ((t_left_index & 1u) == 1) {
-                result = this->m_function(result, this->m_nodes[t_left_index++]);
+                result = this->m_function(result, this->m_tree[t_left_index++]);
             }
             if ((t_right_index & 1u) == 1) {
-                result = this->m_function(result, this->m_nodes[--t_right_index]);
+                result = this->m_function(result, this->m_tree[--t_right_index]);
             }
             t_left_index >>= 1u;
             t_right_index >>= 1u;
@@ -115,6 +168,120 @@ namespace cpa {
         return result;
     }
 
+    template<class TType, class TFunction>
+    void SegmentTree<TType, TFunction>::valueOnSegments(
+            const std::vector<std::pair<std::size_t, std::size_t>> &t_queries, std::vector<TType> &t_result) const {
+        constexpr std::size_t batch_size = 8;
+        constexpr std::size_t prefetch_levels = 4;
+        t_result.clear();
+        t_result.reserve(t_queries.size());
+        for (std::size_t begin = 0; begin < t_queries.size(); begin += batch_size) {
+            auto end = std::min(begin + batch_size, t_queries.size());
+            auto next_end = std::min(end + batch_size, t_queries.size());
+            for (auto q = end; q < next_end; ++q) {
+                auto l = t_queries[q].first + this->m_size;
+                auto r = t_queries[q].second + this->m_size;
+                for (std::size_t level = 0; level < prefetch_levels; ++level) {
+                    prefetch(&this->m_tree[l >> level]);
+                    prefetch(&this->m_tree[r >> level]);
+                }
+            }
+            for (auto q = begin; q < end; ++q) {
+                t_result.push_back(this->valueOnSegment(t_queries[q].first, t_queries[q].second));
+            }
+        }
+    }
+
+    template<class TType, class TFunction>
+    template<class TPredicate>
+    std::size_t SegmentTree<TType, TFunction>::maxRight(std::size_t t_left_index,
+                                                        const TPredicate &t_predicate) const {
+        TType accumulated{};
+        bool has_accumulated = false;
+        auto accepts = [&](const TType &t_value) {
+            auto candidate = has_accumulated ? this->m_function(accumulated, t_value) : t_value;
+            if (!t_predicate(candidate)) {
+                return false;
+            }
+            accumulated = std::move(candidate);
+            has_accumulated = true;
+            return true;
+        };
+        std::size_t left_nodes[std::numeric_limits<std::size_t>::digits];
+        std::size_t right_nodes[std::numeric_limits<std::size_t>::digits];
+        std::size_t left_count = 0, right_count = 0;
+        for (auto l = t_left_index + this->m_size, r = this->m_size << 1u; l < r; l >>= 1u, r >>= 1u) {
+            if ((l & 1u) == 1) {
+                left_nodes[left_count++] = l++;
+            }
+            if ((r & 1u) == 1) {
+                right_nodes[right_count++] = --r;
+            }
+        }
+        while (right_count > 0) {
+            left_nodes[left_count++] = right_nodes[--right_count];
+        }
+        for (std::size_t i = 0; i < left_count; ++i) {
+            auto node = left_nodes[i];
+            if (accepts(this->m_tree[node])) {
+                continue;
+            }
+            while (node < this->m_size) {
+                node <<= 1u;
+                if (accepts(this->m_tree[node])) {
+                    ++node;
+                }
+            }
+            return node - this->m_size;
+        }
+        return this->m_size;
+    }
+
+    template<class TType, class TFunction>
+    template<class TPredicate>
+    std::size_t SegmentTree<TType, TFunction>::minLeft(std::size_t t_right_index,
+                                                       const TPredicate &t_predicate) const {
+        TType accumulated{};
+        bool has_accumulated = false;
+        auto accepts = [&](const TType &t_value) {
+            auto candidate = has_accumulated ? this->m_function(t_value, accumulated) : t_value;
+            if (!t_predicate(candidate)) {
+                return false;
+            }
+            accumulated = std::move(candidate);
+            has_accumulated = true;
+            return true;
+        };
+        std::size_t left_nodes[std::numeric_limits<std::size_t>::digits];
+        std::size_t right_nodes[std::numeric_limits<std::size_t>::digits];
+        std::size_t left_count = 0, right_count = 0;
+        for (auto l = this->m_size, r = t_right_index + this->m_size + 1; l < r; l >>= 1u, r >>= 1u) {
+            if ((l & 1u) == 1) {
+                left_nodes[left_count++] = l++;
+            }
+            if ((r & 1u) == 1) {
+                right_nodes[right_count++] = --r;
+            }
+        }
+        while (left_count > 0) {
+            right_nodes[right_count++] = left_nodes[--left_count];
+        }
+        for (std::size_t i = 0; i < right_count; ++i) {
+            auto node = right_nodes[i];
+            if (accepts(this->m_tree[node])) {
+                continue;
+            }
+            while (node < this->m_size) {
+                node = (node << 1u) | 1u;
+                if (accepts(this->m_tree[node])) {
+                    --node;
+                }
+            }
+            return node - this->m_size + 1;
+        }
+        return 0;
+    }
+
 }
 
 #endif //COMPETITIVE_ALGORITHMS_SEGMENTTREE_H
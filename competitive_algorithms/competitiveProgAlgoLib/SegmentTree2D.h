@@ -0,0 +1,164 @@
+#ifndef COMPETITIVE_ALGORITHMS_SEGMENTTREE2D_H
+#define COMPETITIVE_ALGORITHMS_SEGMENTTREE2D_H
+
+#include <vector>
+#include "IMutableGridDataStructure.h"
+#include "IRectangleSolver.h"
+
+namespace cpa {
+
+    template<class TType, class TFunction = std::function<TType(const TType &, const TType &)>>
+    class SegmentTree2D :
+            public IMutableGridDataStructure<SegmentTree2D<TType, TFunction>, TType>,
+            public IRectangleSolver<SegmentTree2D<TType, TFunction>, TType, TFunction> {
+    private:
+        std::vector<TType> m_nodes;
+
+        template<class TIter>
+        void build(TIter t_begin, TIter t_end);
+
+        [[nodiscard]] std::size_t node(std::size_t t_row, std::size_t t_column) const noexcept;
+
+        void valueOnRow(std::size_t t_row, std::size_t t_first_column, std::size_t t_last_column,
+                        TType &t_result, bool &t_has_result) const;
+
+    public:
+        explicit SegmentTree2D(const TFunction &t_function = TFunction());
+
+        template<class TIter>
+        SegmentTree2D(TIter t_begin, TIter t_end, std::size_t t_columns, const TFunction &t_function = TFunction());
+
+        SegmentTree2D(const SegmentTree2D<TType, TFunction> &other);
+
+        SegmentTree2D(SegmentTree2D<TType, TFunction> &&other) noexcept;
+
+        const TType &getValueAt(std::size_t t_row, std::size_t t_column) const;
+
+        void changeValueAt(std::size_t t_row, std::size_t t_column, const TType &t_value);
+
+        TType valueOnRectangle(std::size_t t_first_row, std::size_t t_first_column,
+                               std::size_t t_last_row, std::size_t t_last_column) const;
+    };
+
+    template<class TType, class TFunction>
+    SegmentTree2D<TType, TFunction>::SegmentTree2D(const TFunction &t_function) {
+        this->m_function = t_function;
+    }
+
+    template<class TType, class TFunction>
+    template<class TIter>
+    SegmentTree2D<TType, TFunction>::SegmentTree2D(TIter t_begin, TIter t_end, std::size_t t_columns,
+                                                   const TFunction &t_function) {
+        this->m_function = t_function;
+        this->m_columns = t_columns;
+        build(t_begin, t_end);
+    }
+
+    template<class TType, class TFunction>
+    SegmentTree2D<TType, TFunction>::SegmentTree2D(const SegmentTree2D<TType, TFunction> &other) {
+        this->m_function = other.m_function;
+        this->m_rows = other.m_rows;
+        this->m_columns = other.m_columns;
+        this->m_nodes = other.m_nodes;
+    }
+
+    template<class TType, class TFunction>
+    SegmentTree2D<TType, TFunction>::SegmentTree2D(SegmentTree2D<TType, TFunction> &&other) noexcept {
+        this->m_function = std::move(other.m_function);
+        this->m_rows = std::move(other.m_rows);
+        this->m_columns = std::move(other.m_columns);
+        this->m_nodes = std::move(other.m_nodes);
+    }
+
+    template<class TType, class TFunction>
+    std::size_t SegmentTree2D<TType, TFunction>::node(std::size_t t_row, std::size_t t_column) const noexcept {
+        return t_row * (this->m_columns << 1u) + t_column;
+    }
+
+    template<class TType, class TFunction>
+    template<class TIter>
+    void SegmentTree2D<TType, TFunction>::build(TIter t_begin, TIter t_end) {
+        this->m_rows = this->m_columns == 0 ? 0 : std::distance(t_begin, t_end) / this->m_columns;
+        if (this->m_rows == 0) {
+            return;
+        }
+        this->m_nodes.resize(this->m_rows * this->m_columns * 4);
+        auto it = t_begin;
+        for (auto i = this->m_rows; i < this->m_rows << 1u; ++i) {
+            for (auto j = this->m_columns; j < this->m_columns << 1u; ++j, ++it) {
+                this->m_nodes[node(i, j)] = *it;
+            }
+            for (auto j = this->m_columns - 1; j > 0; --j) {
+                this->m_nodes[node(i, j)] = this->m_function(this->m_nodes[node(i, j << 1u)],
+                                                             this->m_nodes[node(i, (j << 1u) | 1u)]);
+            }
+        }
+        for (auto i = this->m_rows - 1; i > 0; --i) {
+            for (std::size_t j = 1; j < this->m_columns << 1u; ++j) {
+                this->m_nodes[node(i, j)] = this->m_function(this->m_nodes[node(i << 1u, j)],
+                                                             this->m_nodes[node((i << 1u) | 1u, j)]);
+            }
+        }
+    }
+
+    template<class TType, class TFunction>
+    const TType &SegmentTree2D<TType, TFunction>::getValueAt(std::size_t t_row, std::size_t t_column) const {
+        return this->m_nodes[node(t_row + this->m_rows, t_column + this->m_columns)];
+    }
+
+    template<class TType, class TFunction>
+    void SegmentTree2D<TType, TFunction>::changeValueAt(std::size_t t_row, std::size_t t_column,
+                                                        const TType &t_value) {
+        auto i = t_row + this->m_rows;
+        auto j = t_column + this->m_columns;
+        for (this->m_nodes[node(i, j)] = t_value; j > 1; j >>= 1u) {
+            this->m_nodes[node(i, j >> 1u)] = this->m_function(this->m_nodes[node(i, j)],
+                                                               this->m_nodes[node(i, j ^ 1u)]);
+        }
+        for (; i > 1; i >>= 1u) {
+            for (j = t_column + this->m_columns; j > 0; j >>= 1u) {
+                this->m_nodes[node(i >> 1u, j)] = this->m_function(this->m_nodes[node(i, j)],
+                                                                   this->m_nodes[node(i ^ 1u, j)]);
+            }
+        }
+    }
+
+    template<class TType, class TFunction>
+    void SegmentTree2D<TType, TFunction>::valueOnRow(std::size_t t_row, std::size_t t_first_column,
+                                                     std::size_t t_last_column, TType &t_result,
+                                                     bool &t_has_result) const {
+        for (auto l = t_first_column + this->m_columns, r = t_last_column + this->m_columns + 1; l < r;
+             l >>= 1u, r >>= 1u) {
+            if ((l & 1u) == 1) {
+                auto &value = this->m_nodes[node(t_row, l++)];
+                t_result = t_has_result ? this->m_function(t_result, value) : value;
+                t_has_result = true;
+            }
+            if ((r & 1u) == 1) {
+                auto &value = this->m_nodes[node(t_row, --r)];
+                t_result = t_has_result ? this->m_function(t_result, value) : value;
+                t_has_result = true;
+            }
+        }
+    }
+
+    template<class TType, class TFunction>
+    TType SegmentTree2D<TType, TFunction>::valueOnRectangle(std::size_t t_first_row, std::size_t t_first_column,
+                                                            std::size_t t_last_row,
+                                                            std::size_t t_last_column) const {
+        TType result{};
+        bool has_result = false;
+        for (auto l = t_first_row + this->m_rows, r = t_last_row + this->m_rows + 1; l < r; l >>= 1u, r >>= 1u) {
+            if ((l & 1u) == 1) {
+                valueOnRow(l++, t_first_column, t_last_column, result, has_result);
+            }
+            if ((r & 1u) == 1) {
+                valueOnRow(--r, t_first_column, t_last_column, result, has_result);
+            }
+        }
+        return result;
+    }
+
+}
+
+#endif //COMPETITIVE_ALGORITHMS_SEGMENTTREE2D_H
@@ -0,0 +1,223 @@
+#ifndef COMPETITIVE_ALGORITHMS_SNAPSHOT_H
+#define COMPETITIVE_ALGORITHMS_SNAPSHOT_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace cpa {
+
+    constexpr std::uint32_t snapshot_version = 1;
+    constexpr std::size_t snapshot_alignment = 64;
+
+    enum class SnapshotKind : std::uint32_t {
+        SparseTable = 1,
+        SegmentTree = 2
+    };
+
+    struct SnapshotHeader {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t kind;
+        std::uint32_t type_size;
+        std::uint32_t byte_order;
+        std::uint64_t size;
+        std::uint64_t levels;
+        std::uint64_t data_offset;
+        std::uint64_t data_count;
+        std::uint64_t reserved;
+    };
+
+    static_assert(sizeof(SnapshotHeader) == snapshot_alignment, "SnapshotHeader must fill one aligned block");
+
+    class MappedFile {
+    private:
+        void *m_data = nullptr;
+        std::size_t m_length = 0;
+#if defined(_WIN32)
+        HANDLE m_file = INVALID_HANDLE_VALUE;
+        HANDLE m_mapping = nullptr;
+#endif
+
+    public:
+        MappedFile(const std::string &t_path, bool t_copy_on_write);
+
+        MappedFile(const MappedFile &other) = delete;
+
+        MappedFile &operator=(const MappedFile &other) = delete;
+
+        ~MappedFile();
+
+        [[nodiscard]] void *data() const noexcept;
+
+        [[nodiscard]] std::size_t length() const noexcept;
+    };
+
+    inline MappedFile::MappedFile(const std::string &t_path, bool t_copy_on_write) {
+#if defined(_WIN32)
+        this->m_file = CreateFileA(t_path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr,
+                                   OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        LARGE_INTEGER length;
+        if (this->m_file == INVALID_HANDLE_VALUE || !GetFileSizeEx(this->m_file, &length)) {
+            if (this->m_file != INVALID_HANDLE_VALUE) {
+                CloseHandle(this->m_file);
+            }
+            throw std::runtime_error("cannot open snapshot " + t_path);
+        }
+        this->m_length = static_cast<std::size_t>(length.QuadPart);
+        this->m_mapping = CreateFileMappingA(this->m_file, nullptr, t_copy_on_write ? PAGE_WRITECOPY : PAGE_READONLY,
+                                             0, 0, nullptr);
+        if (this->m_mapping != nullptr) {
+            this->m_data = MapViewOfFile(this->m_mapping, t_copy_on_write ? FILE_MAP_COPY : FILE_MAP_READ, 0, 0, 0);
+        }
+        if (this->m_data == nullptr) {
+            if (this->m_mapping != nullptr) {
+                CloseHandle(this->m_mapping);
+            }
+            CloseHandle(this->m_file);
+            throw std::runtime_error("cannot map snapshot " + t_path);
+        }
+#else
+        auto fd = ::open(t_path.c_str(), O_RDONLY);
+        struct stat status{};
+        if (fd < 0 || fstat(fd, &status) != 0) {
+            if (fd >= 0) {
+                ::close(fd);
+            }
+            throw std::runtime_error("cannot open snapshot " + t_path);
+        }
+        this->m_length = static_cast<std::size_t>(status.st_size);
+        auto data = this->m_length == 0 ? MAP_FAILED :
+                    mmap(nullptr, this->m_length, PROT_READ | (t_copy_on_write ? PROT_WRITE : 0), MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (data == MAP_FAILED) {
+            throw std::runtime_error("cannot map snapshot " + t_path);
+        }
+        this->m_data = data;
+#endif
+    }
+
+    inline MappedFile::~MappedFile() {
+#if defined(_WIN32)
+        UnmapViewOfFile(this->m_data);
+        CloseHandle(this->m_mapping);
+        CloseHandle(this->m_file);
+#else
+        munmap(this->m_data, this->m_length);
+#endif
+    }
+
+    inline void *MappedFile::data() const noexcept {
+        return this->m_data;
+    }
+
+    inline std::size_t MappedFile::length() const noexcept {
+        return this->m_length;
+    }
+
+    namespace detail {
+
+        constexpr char snapshot_magic[8] = {'C', 'P', 'A', 'S', 'N', 'A', 'P', '\0'};
+        constexpr std::uint32_t snapshot_byte_order = 0x01020304;
+
+        template<class TType>
+        void checkSnapshotType() {
+            static_assert(std::is_trivially_copyable_v<TType>, "snapshots require a trivially copyable type");
+            static_assert(alignof(TType) <= snapshot_alignment, "snapshots support at most 64-byte alignment");
+        }
+
+        inline std::string temporarySnapshotPath(const std::string &t_path) {
+            static std::atomic<std::size_t> counter{0};
+#if defined(_WIN32)
+            auto process = static_cast<std::size_t>(GetCurrentProcessId());
+#else
+            auto process = static_cast<std::size_t>(getpid());
+#endif
+            return t_path + "." + std::to_string(process) + "." + std::to_string(counter++) + ".tmp";
+        }
+
+        inline bool replaceSnapshot(const std::string &t_from, const std::string &t_to) {
+#if defined(_WIN32)
+            return MoveFileExA(t_from.c_str(), t_to.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+            return std::rename(t_from.c_str(), t_to.c_str()) == 0;
+#endif
+        }
+
+    }
+
+    template<class TType>
+    void writeSnapshot(const std::string &t_path, SnapshotKind t_kind, std::size_t t_size, std::size_t t_levels,
+                       const TType *t_data, std::size_t t_count) {
+        detail::checkSnapshotType<TType>();
+        SnapshotHeader header{};
+        std::memcpy(header.magic, detail::snapshot_magic, sizeof(header.magic));
+        header.version = snapshot_version;
+        header.kind = static_cast<std::uint32_t>(t_kind);
+        header.type_size = sizeof(TType);
+        header.byte_order = detail::snapshot_byte_order;
+        header.size = t_size;
+        header.levels = t_levels;
+        header.data_offset = sizeof(SnapshotHeader);
+        header.data_count = t_count;
+        auto temporary = detail::temporarySnapshotPath(t_path);
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char *>(t_data), static_cast<std::streamsize>(t_count * sizeof(TType)));
+        out.close();
+        if (!out || !detail::replaceSnapshot(temporary, t_path)) {
+            std::remove(temporary.c_str());
+            throw std::runtime_error("cannot write snapshot " + t_path);
+        }
+    }
+
+    template<class TType>
+    std::shared_ptr<MappedFile> openSnapshot(const std::string &t_path, SnapshotKind t_kind, bool t_copy_on_write,
+                                             SnapshotHeader &t_header) {
+        detail::checkSnapshotType<TType>();
+        auto file = std::make_shared<MappedFile>(t_path, t_copy_on_write);
+        if (file->length() < sizeof(SnapshotHeader)) {
+            throw std::runtime_error("truncated snapshot " + t_path);
+        }
+        std::memcpy(&t_header, file->data(), sizeof(SnapshotHeader));
+        if (std::memcmp(t_header.magic, detail::snapshot_magic, sizeof(t_header.magic)) != 0 ||
+            t_header.version != snapshot_version || t_header.byte_order != detail::snapshot_byte_order) {
+            throw std::runtime_error("unsupported snapshot " + t_path);
+        }
+        if (t_header.kind != static_cast<std::uint32_t>(t_kind) || t_header.type_size != sizeof(TType) ||
+            t_header.data_offset % snapshot_alignment != 0) {
+            throw std::runtime_error("snapshot layout mismatch " + t_path);
+        }
+        if (t_header.data_offset > file->length() ||
+            t_header.data_count > (file->length() - t_header.data_offset) / sizeof(TType)) {
+            throw std::runtime_error("truncated snapshot " + t_path);
+        }
+        return file;
+    }
+
+    template<class TType>
+    TType *snapshotData(const std::shared_ptr<MappedFile> &t_file, const SnapshotHeader &t_header) noexcept {
+        return reinterpret_cast<TType *>(static_cast<char *>(t_file->data()) + t_header.data_offset);
+    }
+
+}
+
+#endif //COMPETITIVE_ALGORITHMS_SNAPSHOT_H
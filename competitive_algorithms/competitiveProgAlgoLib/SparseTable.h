@@ -1,38 +1,53 @@
 #ifndef COMPETITIVE_ALGORITHMS_SPARSETABLE_H
 #define COMPETITIVE_ALGORITHMS_SPARSETABLE_H
 
+#include <memory>
+#include <string>
 #include <vector>
 #include "ISegmentSolver.h"
 #include "IDataStructure.h"
+#include "Intrinsics.h"
+#include "Parallel.h"
+#include "Snapshot.h"
 
 namespace cpa {
 
     template<class TType, class TFunction = std::function<TType(const TType &, const TType &)>>
     class SparseTable :
-            public IDataStructure<TType>,
-            public ISegmentSolver<TType, TFunction> {
+            public IDataStructure<SparseTable<TType, TFunction>, TType>,
+            public ISegmentSolver<SparseTable<TType, TFunction>, TType, TFunction> {
     private:
-        std::vector<std::size_t> m_log;
-        std::vector<std::vector<TType>> m_st;
+        std::size_t m_levels{};
+        std::vector<TType> m_st;
+        const TType *m_table = nullptr;
+        std::shared_ptr<MappedFile> m_mapping;
 
-        void calculateLog();
+        [[nodiscard]] std::size_t levelOffset(std::size_t t_level) const noexcept;
 
         template<class TIter>
-        void calculateSparseTable(TIter t_begin, TIter t_end);
+        void calculateSparseTable(TIter t_begin, TIter t_end, std::size_t t_thread_count);
 
     public:
-        explicit SparseTable(const TFunction &t_function = nullptr);
+        explicit SparseTable(const TFunction &t_function = TFunction());
 
         template<class TIter>
-        SparseTable(TIter t_begin, TIter t_end, const TFunction &t_function = nullptr);
+        SparseTable(TIter t_begin, TIter t_end, const TFunction &t_function = TFunction(),
+                    std::size_t t_thread_count = 1);
 
         SparseTable(const SparseTable<TType, TFunction> &other);
 
         SparseTable(SparseTable<TType, TFunction> &&other) noexcept;
 
-        const TType &getValueAt(std::size_t t_index) const override;
+        void save(const std::string &t_path) const;
 
-        TType valueOnSegment(std::size_t t_left_index, std::size_t t_right_index) const override;
+        static SparseTable<TType, TFunction> open(const std::string &t_path, const TFunction &t_function = TFunction());
+
+        const TType &getValueAt(std::size_t t_index) const;
+
+        TType valueOnSegment(std::size_t t_left_index, std::size_t t_right_index) const;
+
+        void valueOnSegments(const std::vector<std::pair<std::size_t, std::size_t>> &t_queries,
+                             std::vector<TType> &t_result) const;
     };
 
 
@@ -43,61 +58,114 @@ namespace cpa {
 
     template<class TType, class TFunction>
     template<class TIter>
-    SparseTable<TType, TFunction>::SparseTable(TIter t_begin, TIter t_end, const TFunction &t_function) {
+    SparseTable<TType, TFunction>::SparseTable(TIter t_begin, TIter t_end, const TFunction &t_function,
+                                               std::size_t t_thread_count) {
         this->m_function = t_function;
         this->m_size = std::distance(t_begin, t_end);
-        this->calculateLog();
-        this->calculateSparseTable(t_begin, t_end);
+        this->calculateSparseTable(t_begin, t_end, resolveThreadCount(t_thread_count));
     }
 
     template<class TType, class TFunction>
-    void SparseTable<TType, TFunction>::calculateLog() {
-        this->m_log.resize(this->m_size);
-        this->m_log[0] = 0;
-        this->m_log[1] = 0;
-        for (std::size_t i = 2; i < this->m_log.size(); ++i) {
-            this->m_log[i] = this->m_log[i / 2] + 1;
-        }
+    std::size_t SparseTable<TType, TFunction>::levelOffset(std::size_t t_level) const noexcept {
+        return t_level * (this->m_size + 1) - (std::size_t{1} << t_level) + 1;
     }
 
     template<class TType, class TFunction>
     template<class TIter>
-    void SparseTable<TType, TFunction>::calculateSparseTable(TIter t_begin, TIter t_end) {
-        this->m_st.resize(this->m_log.back() + 1);
-        this->m_st[0].assign(t_begin, t_end);
-        for (std::size_t i = 1; i < this->m_st.size(); ++i) {
-            this->m_st[i].resize(this->m_size - (1u << i) + 1);
-            for (std::size_t j = 0; j < this->m_st[i].size(); ++j) {
-                this->m_st[i][j] = this->m_function(this->m_st[i - 1][j], this->m_st[i - 1][j + (1u << (i - 1))]);
-            }
+    void SparseTable<TType, TFunction>::calculateSparseTable(TIter t_begin, TIter t_end, std::size_t t_thread_count) {
+        this->m_levels = bitWidth(this->m_size);
+        this->m_st.reserve(levelOffset(this->m_levels));
+        this->m_st.assign(t_begin, t_end);
+        this->m_st.resize(levelOffset(this->m_levels));
+        countRebuild(this->m_function, this->m_st);
+        for (std::size_t i = 1; i < this->m_levels; ++i) {
+            auto previous = this->m_st.begin() + levelOffset(i - 1);
+            auto current = this->m_st.begin() + levelOffset(i);
+            auto half = std::size_t{1} << (i - 1);
+            auto level_size = this->m_size - (std::size_t{1} << i) + 1;
+            parallelFor(0, level_size, t_thread_count, [&](std::size_t j) {
+                current[j] = this->m_function(previous[j], previous[j + half]);
+            });
         }
+        this->m_table = this->m_st.data();
     }
 
     template<class TType, class TFunction>
     SparseTable<TType, TFunction>::SparseTable(const SparseTable<TType, TFunction> &other) {
         this->m_function = other.m_function;
         this->m_size = other.m_size;
-        this->m_log = other.m_log;
+        this->m_levels = other.m_levels;
         this->m_st = other.m_st;
+        this->m_mapping = other.m_mapping;
+        this->m_table = this->m_mapping ? other.m_table : this->m_st.data();
     }
 
     template<class TType, class TFunction>
     SparseTable<TType, TFunction>::SparseTable(SparseTable<TType, TFunction> &&other) noexcept {
         this->m_function = std::move(other.m_function);
         this->m_size = std::move(other.m_size);
-        this->m_log = std::move(other.m_log);
+        this->m_levels = std::move(other.m_levels);
         this->m_st = std::move(other.m_st);
+        this->m_mapping = std::move(other.m_mapping);
+        this->m_table = other.m_table;
+        other.m_table = nullptr;
+    }
+
+    template<class TType, class TFunction>
+    void SparseTable<TType, TFunction>::save(const std::string &t_path) const {
+        writeSnapshot(t_path, SnapshotKind::SparseTable, this->m_size, this->m_levels, this->m_table,
+                      this->m_size == 0 ? 0 : levelOffset(this->m_levels));
+    }
+
+    template<class TType, class TFunction>
+    SparseTable<TType, TFunction> SparseTable<TType, TFunction>::open(const std::string &t_path,
+                                                                      const TFunction &t_function) {
+        SnapshotHeader header{};
+        SparseTable<TType, TFunction> result(t_function);
+        result.m_mapping = openSnapshot<TType>(t_path, SnapshotKind::SparseTable, false, header);
+        result.m_size = header.size;
+        result.m_levels = header.levels;
+        if (header.size > header.data_count || header.levels != bitWidth(header.size) ||
+            header.data_count != (result.m_size == 0 ? 0 : result.levelOffset(result.m_levels))) {
+            throw std::runtime_error("snapshot layout mismatch " + t_path);
+        }
+        result.m_table = snapshotData<TType>(result.m_mapping, header);
+        return result;
     }
 
     template<class TType, class TFunction>
     const TType &SparseTable<TType, TFunction>::getValueAt(std::size_t t_index) const {
-        return this->m_st[0][t_index];
+        return this->m_table[t_index];
     }
 
     template<class TType, class TFunction>
     TType SparseTable<TType, TFunction>::valueOnSegment(std::size_t t_left_index, std::size_t t_right_index) const {
-        auto i = this->m_log[t_right_index - t_left_index];
-        return this->m_function(this->m_st[i][t_left_index], this->m_st[i][t_right_index - (1u << i) + 1]);
+        auto i = bitWidth(t_right_index - t_left_index + 1) - 1;
+        auto offset = levelOffset(i);
+        return this->m_function(this->m_table[offset + t_left_index],
+                                this->m_table[offset + t_right_index + 1 - (std::size_t{1} << i)]);
+    }
+
+    template<class TType, class TFunction>
+    void SparseTable<TType, TFunction>::valueOnSegments(
+            const std::vector<std::pair<std::size_t, std::size_t>> &t_queries, std::vector<TType> &t_result) const {
+        constexpr std::size_t batch_size = 16;
+        t_result.clear();
+        t_result.reserve(t_queries.size());
+        for (std::size_t begin = 0; begin < t_queries.size(); begin += batch_size) {
+            auto end = std::min(begin + batch_size, t_queries.size());
+            auto next_end = std::min(end + batch_size, t_queries.size());
+            for (auto q = end; q < next_end; ++q) {
+                auto &[l, r] = t_queries[q];
+                auto i = bitWidth(r - l + 1) - 1;
+                auto offset = levelOffset(i);
+                prefetch(&this->m_table[offset + l]);
+                prefetch(&this->m_table[offset + r + 1 - (std::size_t{1} << i)]);
+            }
+            for (auto q = begin; q < end; ++q) {
+                t_result.push_back(this->valueOnSegment(t_queries[q].first, t_queries[q].second));
+            }
+        }
     }
 
 }
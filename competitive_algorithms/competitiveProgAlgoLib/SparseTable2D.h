@@ -0,0 +1,158 @@
+#ifndef COMPETITIVE_ALGORITHMS_SPARSETABLE2D_H
+#define COMPETITIVE_ALGORITHMS_SPARSETABLE2D_H
+
+#include <vector>
+#include "IGridDataStructure.h"
+#include "IRectangleSolver.h"
+#include "Intrinsics.h"
+#include "Parallel.h"
+
+namespace cpa {
+
+    template<class TType, class TFunction = std::function<TType(const TType &, const TType &)>>
+    class SparseTable2D :
+            public IGridDataStructure<SparseTable2D<TType, TFunction>, TType>,
+            public IRectangleSolver<SparseTable2D<TType, TFunction>, TType, TFunction> {
+    private:
+        std::size_t m_row_levels{};
+        std::size_t m_column_levels{};
+        std::vector<std::size_t> m_offsets;
+        std::vector<TType> m_st;
+
+        [[nodiscard]] std::size_t levelWidth(std::size_t t_column_level) const noexcept;
+
+        template<class TIter>
+        void calculateSparseTable(TIter t_begin, TIter t_end, std::size_t t_thread_count);
+
+    public:
+        explicit SparseTable2D(const TFunction &t_function = TFunction());
+
+        template<class TIter>
+        SparseTable2D(TIter t_begin, TIter t_end, std::size_t t_columns, const TFunction &t_function = TFunction(),
+                      std::size_t t_thread_count = 1);
+
+        SparseTable2D(const SparseTable2D<TType, TFunction> &other);
+
+        SparseTable2D(SparseTable2D<TType, TFunction> &&other) noexcept;
+
+        const TType &getValueAt(std::size_t t_row, std::size_t t_column) const;
+
+        TType valueOnRectangle(std::size_t t_first_row, std::size_t t_first_column,
+                               std::size_t t_last_row, std::size_t t_last_column) const;
+    };
+
+    template<class TType, class TFunction>
+    SparseTable2D<TType, TFunction>::SparseTable2D(const TFunction &t_function) {
+        this->m_function = t_function;
+    }
+
+    template<class TType, class TFunction>
+    template<class TIter>
+    SparseTable2D<TType, TFunction>::SparseTable2D(TIter t_begin, TIter t_end, std::size_t t_columns,
+                                                   const TFunction &t_function, std::size_t t_thread_count) {
+        this->m_function = t_function;
+        this->m_columns = t_columns;
+        this->m_rows = t_columns == 0 ? 0 : std::distance(t_begin, t_end) / t_columns;
+        calculateSparseTable(t_begin, t_end, resolveThreadCount(t_thread_count));
+    }
+
+    template<class TType, class TFunction>
+    SparseTable2D<TType, TFunction>::SparseTable2D(const SparseTable2D<TType, TFunction> &other) {
+        this->m_function = other.m_function;
+        this->m_rows = other.m_rows;
+        this->m_columns = other.m_columns;
+        this->m_row_levels = other.m_row_levels;
+        this->m_column_levels = other.m_column_levels;
+        this->m_offsets = other.m_offsets;
+        this->m_st = other.m_st;
+    }
+
+    template<class TType, class TFunction>
+    SparseTable2D<TType, TFunction>::SparseTable2D(SparseTable2D<TType, TFunction> &&other) noexcept {
+        this->m_function = std::move(other.m_function);
+        this->m_rows = std::move(other.m_rows);
+        this->m_columns = std::move(other.m_columns);
+        this->m_row_levels = std::move(other.m_row_levels);
+        this->m_column_levels = std::move(other.m_column_levels);
+        this->m_offsets = std::move(other.m_offsets);
+        this->m_st = std::move(other.m_st);
+    }
+
+    template<class TType, class TFunction>
+    std::size_t SparseTable2D<TType, TFunction>::levelWidth(std::size_t t_column_level) const noexcept {
+        return this->m_columns - (std::size_t{1} << t_column_level) + 1;
+    }
+
+    template<class TType, class TFunction>
+    template<class TIter>
+    void SparseTable2D<TType, TFunction>::calculateSparseTable(TIter t_begin, TIter t_end,
+                                                               std::size_t t_thread_count) {
+        this->m_row_levels = bitWidth(this->m_rows);
+        this->m_column_levels = bitWidth(this->m_columns);
+        std::size_t total = 0;
+        for (std::size_t i = 0; i < this->m_row_levels; ++i) {
+            for (std::size_t j = 0; j < this->m_column_levels; ++j) {
+                this->m_offsets.push_back(total);
+                total += (this->m_rows - (std::size_t{1} << i) + 1) * levelWidth(j);
+            }
+        }
+        this->m_st.reserve(total);
+        this->m_st.assign(t_begin, t_end);
+        this->m_st.resize(total);
+        for (std::size_t i = 0; i < this->m_row_levels; ++i) {
+            auto level_rows = this->m_rows - (std::size_t{1} << i) + 1;
+            for (std::size_t j = 0; j < this->m_column_levels; ++j) {
+                if (i == 0 && j == 0) {
+                    continue;
+                }
+                auto width = levelWidth(j);
+                auto current = this->m_st.begin() + this->m_offsets[i * this->m_column_levels + j];
+                if (i == 0) {
+                    auto previous = this->m_st.begin() + this->m_offsets[j - 1];
+                    auto previous_width = levelWidth(j - 1);
+                    auto half = std::size_t{1} << (j - 1);
+                    parallelFor(0, level_rows, t_thread_count, [&](std::size_t r) {
+                        for (std::size_t c = 0; c < width; ++c) {
+                            current[r * width + c] = this->m_function(previous[r * previous_width + c],
+                                                                      previous[r * previous_width + c + half]);
+                        }
+                    });
+                } else {
+                    auto previous = this->m_st.begin() + this->m_offsets[(i - 1) * this->m_column_levels + j];
+                    auto half = (std::size_t{1} << (i - 1)) * width;
+                    parallelFor(0, level_rows, t_thread_count, [&](std::size_t r) {
+                        for (std::size_t c = 0; c < width; ++c) {
+                            current[r * width + c] = this->m_function(previous[r * width + c],
+                                                                      previous[r * width + c + half]);
+                        }
+                    });
+                }
+            }
+        }
+    }
+
+    template<class TType, class TFunction>
+    const TType &SparseTable2D<TType, TFunction>::getValueAt(std::size_t t_row, std::size_t t_column) const {
+        return this->m_st[t_row * this->m_columns + t_column];
+    }
+
+    template<class TType, class TFunction>
+    TType SparseTable2D<TType, TFunction>::valueOnRectangle(std::size_t t_first_row, std::size_t t_first_column,
+                                                            std::size_t t_last_row,
+                                                            std::size_t t_last_column) const {
+        auto i = bitWidth(t_last_row - t_first_row + 1) - 1;
+        auto j = bitWidth(t_last_column - t_first_column + 1) - 1;
+        auto width = levelWidth(j);
+        auto table = this->m_st.begin() + this->m_offsets[i * this->m_column_levels + j];
+        auto second_row = t_last_row + 1 - (std::size_t{1} << i);
+        auto second_column = t_last_column + 1 - (std::size_t{1} << j);
+        auto top = this->m_function(table[t_first_row * width + t_first_column],
+                                    table[t_first_row * width + second_column]);
+        auto bottom = this->m_function(table[second_row * width + t_first_column],
+                                       table[second_row * width + second_column]);
+        return this->m_function(top, bottom);
+    }
+
+}
+
+#endif //COMPETITIVE_ALGORITHMS_SPARSETABLE2D_H
@@ -1,127 +1,242 @@
 #ifndef COMPETITIVE_ALGORITHMS_SQRTDECOMPOSER_H
 #define COMPETITIVE_ALGORITHMS_SQRTDECOMPOSER_H
 
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include "ISegmentSolver.h"
 #include "IMutableDataStructure.h"
+#include "LazyAction.h"
+#include "Reduce.h"
 
 namespace cpa {
 
-    template<class TType, class TFunction = std::function<TType(const TType &, const TType &)>>
+    template<class TType, class TFunction = std::function<TType(const TType &, const TType &)>,
+            class TAction = AddAction<TType>>
     class SqrtDecomposer :
-            public IMutableDataStructure<TType>,
-            public ISegmentSolver<TType, TFunction> {
+            public IMutableDataStructure<SqrtDecomposer<TType, TFunction, TAction>, TType>,
+            public ISegmentSolver<SqrtDecomposer<TType, TFunction, TAction>, TType, TFunction> {
+    public:
+        using tag_type = typename TAction::tag_type;
+
     private:
         std::vector<TType> m_data;
         std::vector<TType> m_block_data;
+        std::vector<tag_type> m_tags;
+        std::vector<std::int8_t> m_pending;
         std::size_t m_block_size;
 
         template<class TIter>
-        void build(TIter t_begin, TIter t_end);
+        void build(TIter t_begin, TIter t_end, std::size_t t_block_size);
+
+        [[nodiscard]] std::size_t blockEnd(std::size_t t_block) const noexcept;
+
+        void pushBlock(std::size_t t_block);
+
+        TType reduceInBlock(std::size_t t_begin, std::size_t t_end, TType t_init) const;
+
+        void rebuildBlock(std::size_t t_block);
+
+        void applyInBlock(std::size_t t_left_index, std::size_t t_right_index, const tag_type &t_tag);
 
     public:
-        explicit SqrtDecomposer(const TFunction &t_function = nullptr);
+        explicit SqrtDecomposer(const TFunction &t_function = TFunction());
 
         template<class TIter>
-        SqrtDecomposer(TIter t_begin, TIter t_end, const TFunction &t_function = nullptr);
+        SqrtDecomposer(TIter t_begin, TIter t_end, const TFunction &t_function = TFunction(),
+                       std::size_t t_block_size = 0);
+
+        SqrtDecomposer(const SqrtDecomposer<TType, TFunction, TAction> &other);
+
+        SqrtDecomposer(SqrtDecomposer<TType, TFunction, TAction> &&other) noexcept;
 
-        SqrtDecomposer(const SqrtDecomposer<TType, TFunction> &other);
+        [[nodiscard]] std::size_t blockSize() const noexcept;
 
-        SqrtDecomposer(SqrtDecomposer<TType, TFunction> &&other) noexcept;
+        TType getValueAt(std::size_t t_index) const;
 
-        const TType &getValueAt(std::size_t t_index) const override;
+        void changeValueAt(std::size_t t_index, const TType &t_value);
 
-        void changeValueAt(std::size_t t_index, const TType &t_value) override;
+        void applyOnSegment(std::size_t t_left_index, std::size_t t_right_index, const tag_type &t_tag);
 
-        TType valueOnSegment(std::size_t t_left_index, std::size_t t_right_index) const override;
+        TType valueOnSegment(std::size_t t_left_index, std::size_t t_right_index) const;
     };
 
-    template<class TType, class TFunction>
-    SqrtDecomposer<TType, TFunction>::SqrtDecomposer(const TFunction &t_function) {
+    template<class TType, class TFunction, class TAction>
+    SqrtDecomposer<TType, TFunction, TAction>::SqrtDecomposer(const TFunction &t_function) {
         this->m_function = t_function;
         this->m_block_size = 0;
     }
 
-    template<class TType, class TFunction>
+    template<class TType, class TFunction, class TAction>
     template<class TIter>
-    SqrtDecomposer<TType, TFunction>::SqrtDecomposer(TIter t_begin, TIter t_end, const TFunction &t_function) {
+    SqrtDecomposer<TType, TFunction, TAction>::SqrtDecomposer(TIter t_begin, TIter t_end,
+                                                              const TFunction &t_function,
+                                                              std::size_t t_block_size) {
         this->m_function = t_function;
-        this->build(t_begin, t_end);
+        this->build(t_begin, t_end, t_block_size);
     }
 
-    template<class TType, class TFunction>
-    SqrtDecomposer<TType, TFunction>::SqrtDecomposer(const SqrtDecomposer<TType, TFunction> &other) {
+    template<class TType, class TFunction, class TAction>
+    SqrtDecomposer<TType, TFunction, TAction>::SqrtDecomposer(const SqrtDecomposer<TType, TFunction, TAction> &other) {
         this->m_function = other.m_function;
         this->m_size = other.m_size;
         this->m_block_size = other.m_block_size;
         this->m_data = other.m_data;
         this->m_block_data = other.m_block_data;
+        this->m_tags = other.m_tags;
+        this->m_pending = other.m_pending;
     }
 
-    template<class TType, class TFunction>
-    SqrtDecomposer<TType, TFunction>::SqrtDecomposer(SqrtDecomposer<TType, TFunction> &&other) noexcept {
+    template<class TType, class TFunction, class TAction>
+    SqrtDecomposer<TType, TFunction, TAction>::SqrtDecomposer(
+            SqrtDecomposer<TType, TFunction, TAction> &&other) noexcept {
         this->m_function = std::move(other.m_function);
         this->m_size = std::move(other.m_size);
         this->m_block_size = std::move(other.m_block_size);
         this->m_data = std::move(other.m_data);
         this->m_block_data = std::move(other.m_block_data);
+        this->m_tags = std::move(other.m_tags);
+        this->m_pending = std::move(other.m_pending);
     }
 
-    template<class TType, class TFunction>
+    template<class TType, class TFunction, class TAction>
     template<class TIter>
-    void SqrtDecomposer<TType, TFunction>::build(TIter t_begin, TIter t_end) {
+    void SqrtDecomposer<TType, TFunction, TAction>::build(TIter t_begin, TIter t_end, std::size_t t_block_size) {
+        constexpr std::size_t cache_line_size = 64;
         this->m_data.assign(t_begin, t_end);
         this->m_size = this->m_data.size();
-        this->m_block_size = static_cast<int>(std::sqrt(this->m_size));
+        this->m_block_size = t_block_size;
+        if (this->m_block_size == 0) {
+            auto line = std::max<std::size_t>(1, cache_line_size / sizeof(TType));
+            auto root = std::max<std::size_t>(1, static_cast<std::size_t>(std::sqrt(this->m_size)));
+            this->m_block_size = (root + line - 1) / line * line;
+        }
         if (this->m_size == 0) {
             return;
         }
-        for (std::size_t i = 0; i < this->m_size; ++i) {
-            if (i % this->m_block_size == 0) {
-                this->m_block_data.push_back(this->m_data[i]);
-            } else {
-                this->m_block_data.back() = this->m_function(this->m_block_data.back(), this->m_data[i]);
-            }
+        auto data = this->m_data.data();
+        for (std::size_t i = 0; i < this->m_size; i += this->m_block_size) {
+            auto end = std::min(i + this->m_block_size, this->m_size);
+            this->m_block_data.push_back(reduceSegment(data + i + 1, data + end, data[i], this->m_function));
         }
+        this->m_tags.assign(this->m_block_data.size(), TAction::identity());
+        this->m_pending.assign(this->m_block_data.size(), 0);
+        countRebuild(this->m_function, this->m_data, this->m_block_data, this->m_tags, this->m_pending);
     }
 
-    template<class TType, class TFunction>
-    const TType &SqrtDecomposer<TType, TFunction>::getValueAt(std::size_t t_index) const {
+    template<class TType, class TFunction, class TAction>
+    std::size_t SqrtDecomposer<TType, TFunction, TAction>::blockEnd(std::size_t t_block) const noexcept {
+        return std::min((t_block + 1) * this->m_block_size, this->m_size);
+    }
+
+    template<class TType, class TFunction, class TAction>
+    void SqrtDecomposer<TType, TFunction, TAction>::pushBlock(std::size_t t_block) {
+        if (!this->m_pending[t_block]) {
+            return;
+        }
+        for (auto i = t_block * this->m_block_size; i < blockEnd(t_block); ++i) {
+            this->m_data[i] = TAction::apply(this->m_data[i], this->m_tags[t_block], 1);
+        }
+        this->m_tags[t_block] = TAction::identity();
+        this->m_pending[t_block] = 0;
+    }
+
+    template<class TType, class TFunction, class TAction>
+    TType SqrtDecomposer<TType, TFunction, TAction>::reduceInBlock(std::size_t t_begin, std::size_t t_end,
+                                                                   TType t_init) const {
+        if (t_begin == t_end) {
+            return t_init;
+        }
+        auto block = t_begin / this->m_block_size;
+        if (!this->m_pending[block]) {
+            return reduceSegment(this->m_data.data() + t_begin, this->m_data.data() + t_end, t_init,
+                                 this->m_function);
+        }
+        for (auto i = t_begin; i < t_end; ++i) {
+            t_init = this->m_function(t_init, TAction::apply(this->m_data[i], this->m_tags[block], 1));
+        }
+        return t_init;
+    }
+
+    template<class TType, class TFunction, class TAction>
+    void SqrtDecomposer<TType, TFunction, TAction>::rebuildBlock(std::size_t t_block) {
+        auto begin = this->m_data.data() + t_block * this->m_block_size;
+        auto end = this->m_data.data() + blockEnd(t_block);
+        this->m_block_data[t_block] = reduceSegment(begin + 1, end, *begin, this->m_function);
+    }
+
+    template<class TType, class TFunction, class TAction>
+    void SqrtDecomposer<TType, TFunction, TAction>::applyInBlock(std::size_t t_left_index, std::size_t t_right_index,
+                                                                 const tag_type &t_tag) {
+        auto block = t_left_index / this->m_block_size;
+        pushBlock(block);
+        for (auto i = t_left_index; i <= t_right_index; ++i) {
+            this->m_data[i] = TAction::apply(this->m_data[i], t_tag, 1);
+        }
+        rebuildBlock(block);
+    }
+
+    template<class TType, class TFunction, class TAction>
+    std::size_t SqrtDecomposer<TType, TFunction, TAction>::blockSize() const noexcept {
+        return this->m_block_size;
+    }
+
+    template<class TType, class TFunction, class TAction>
+    TType SqrtDecomposer<TType, TFunction, TAction>::getValueAt(std::size_t t_index) const {
+        auto block = t_index / this->m_block_size;
+        if (this->m_pending[block]) {
+            return TAction::apply(this->m_data[t_index], this->m_tags[block], 1);
+        }
         return this->m_data[t_index];
     }
 
-    template<class TType, class TFunction>
-    void SqrtDecomposer<TType, TFunction>::changeValueAt(std::size_t t_index, const TType &t_value) {
-        this->m_data[t_index] = t_value;
+    template<class TType, class TFunction, class TAction>
+    void SqrtDecomposer<TType, TFunction, TAction>::changeValueAt(std::size_t t_index, const TType &t_value) {
         auto block = t_index / this->m_block_size;
-        this->m_block_data[block] = this->m_data[block * this->m_block_size];
-        for (std::size_t i = 1; i < this->m_block_size; ++i) {
-            this->m_block_data[block] = this->m_function(this->m_block_data[block],
-                                                         this->m_data[block * this->m_block_size + i]);
+        pushBlock(block);
+        if constexpr (MonoidTraits<TFunction>::invertible) {
+            auto &block_value = this->m_block_data[block];
+            block_value = this->m_function(this->m_function(block_value, TFunction::inverse(this->m_data[t_index])),
+                                           t_value);
+            this->m_data[t_index] = t_value;
+        } else {
+            this->m_data[t_index] = t_value;
+            rebuildBlock(block);
         }
     }
 
-    template<class TType, class TFunction>
-    TType SqrtDecomposer<TType, TFunction>::valueOnSegment(std::size_t t_left_index, std::size_t t_right_index) const {
+    template<class TType, class TFunction, class TAction>
+    void SqrtDecomposer<TType, TFunction, TAction>::applyOnSegment(std::size_t t_left_index,
+                                                                   std::size_t t_right_index,
+                                                                   const tag_type &t_tag) {
         auto l_block = t_left_index / this->m_block_size;
         auto r_block = t_right_index / this->m_block_size;
-        auto result = this->m_data[t_left_index];
         if (l_block == r_block) {
-            for (auto i = t_left_index + 1; i <= t_right_index; ++i) {
-                result = this->m_function(result, this->m_data[i]);
-            }
-        } else {
-            for (auto i = t_left_index + 1; i < (l_block + 1) * this->m_block_size; ++i) {
-                result = this->m_function(result, this->m_data[i]);
-            }
-            for (auto i = l_block + 1; i < r_block; ++i) {
-                result = this->m_function(result, this->m_block_data[i]);
-            }
-            for (auto i = r_block * this->m_block_size; i <= t_right_index; ++i) {
-                result = this->m_function(result, this->m_data[i]);
-            }
+            applyInBlock(t_left_index, t_right_index, t_tag);
+            return;
+        }
+        applyInBlock(t_left_index, blockEnd(l_block) - 1, t_tag);
+        for (auto i = l_block + 1; i < r_block; ++i) {
+            this->m_block_data[i] = TAction::apply(this->m_block_data[i], t_tag, this->m_block_size);
+            this->m_tags[i] = TAction::compose(t_tag, this->m_tags[i]);
+            this->m_pending[i] = 1;
+        }
+        applyInBlock(r_block * this->m_block_size, t_right_index, t_tag);
+    }
+
+    template<class TType, class TFunction, class TAction>
+    TType SqrtDecomposer<TType, TFunction, TAction>::valueOnSegment(std::size_t t_left_index,
+                                                                    std::size_t t_right_index) const {
+        auto l_block = t_left_index / this->m_block_size;
+        auto r_block = t_right_index / this->m_block_size;
+        auto block_data = this->m_block_data.data();
+        auto result = this->getValueAt(t_left_index);
+        if (l_block == r_block) {
+            return reduceInBlock(t_left_index + 1, t_right_index + 1, result);
         }
-        return result;
+        result = reduceInBlock(t_left_index + 1, (l_block + 1) * this->m_block_size, result);
+        result = reduceSegment(block_data + l_block + 1, block_data + r_block, result, this->m_function);
+        return reduceInBlock(r_block * this->m_block_size, t_right_index + 1, result);
     }
 
 }
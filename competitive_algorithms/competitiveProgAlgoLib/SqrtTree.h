@@ -0,0 +1,278 @@
+#ifndef COMPETITIVE_ALGORITHMS_SQRTTREE_H
+#define COMPETITIVE_ALGORITHMS_SQRTTREE_H
+
+#include <algorithm>
+#include <vector>
+#include "IMutableDataStructure.h"
+#include "ISegmentSolver.h"
+#include "Intrinsics.h"
+
+namespace cpa {
+
+    template<class TType, class TFunction = std::function<TType(const TType &, const TType &)>>
+    class SqrtTree :
+            public IMutableDataStructure<SqrtTree<TType, TFunction>, TType>,
+            public ISegmentSolver<SqrtTree<TType, TFunction>, TType, TFunction> {
+    private:
+        std::size_t m_lg{};
+        std::size_t m_index_size{};
+        std::size_t m_row_size{};
+        std::size_t m_between_row_size{};
+        std::vector<TType> m_data;
+        std::vector<std::size_t> m_layers;
+        std::vector<std::size_t> m_on_layer;
+        std::vector<TType> m_prefix;
+        std::vector<TType> m_suffix;
+        std::vector<TType> m_between;
+
+        template<class TIter>
+        void build(TIter t_begin, TIter t_end);
+
+        void buildBlock(std::size_t t_layer, std::size_t t_left, std::size_t t_right);
+
+        void buildBetween(std::size_t t_layer, std::size_t t_left_bound, std::size_t t_right_bound,
+                          std::size_t t_between_offset);
+
+        void buildBetweenZero();
+
+        void updateBetweenZero(std::size_t t_block);
+
+        void build(std::size_t t_layer, std::size_t t_left_bound, std::size_t t_right_bound,
+                   std::size_t t_between_offset);
+
+        void update(std::size_t t_layer, std::size_t t_left_bound, std::size_t t_right_bound,
+                    std::size_t t_between_offset, std::size_t t_index);
+
+        TType valueOnSegment(std::size_t t_left_index, std::size_t t_right_index, std::size_t t_between_offset,
+                             std::size_t t_base) const;
+
+    public:
+        explicit SqrtTree(const TFunction &t_function = TFunction());
+
+        template<class TIter>
+        SqrtTree(TIter t_begin, TIter t_end, const TFunction &t_function = TFunction());
+
+        SqrtTree(const SqrtTree<TType, TFunction> &other);
+
+        SqrtTree(SqrtTree<TType, TFunction> &&other) noexcept;
+
+        const TType &getValueAt(std::size_t t_index) const;
+
+        void changeValueAt(std::size_t t_index, const TType &t_value);
+
+        TType valueOnSegment(std::size_t t_left_index, std::size_t t_right_index) const;
+    };
+
+    template<class TType, class TFunction>
+    SqrtTree<TType, TFunction>::SqrtTree(const TFunction &t_function) {
+        this->m_function = t_function;
+    }
+
+    template<class TType, class TFunction>
+    template<class TIter>
+    SqrtTree<TType, TFunction>::SqrtTree(TIter t_begin, TIter t_end, const TFunction &t_function) {
+        this->m_function = t_function;
+        build(t_begin, t_end);
+    }
+
+    template<class TType, class TFunction>
+    SqrtTree<TType, TFunction>::SqrtTree(const SqrtTree<TType, TFunction> &other) {
+        this->m_function = other.m_function;
+        this->m_size = other.m_size;
+        this->m_lg = other.m_lg;
+        this->m_index_size = other.m_index_size;
+        this->m_row_size = other.m_row_size;
+        this->m_between_row_size = other.m_between_row_size;
+        this->m_data = other.m_data;
+        this->m_layers = other.m_layers;
+        this->m_on_layer = other.m_on_layer;
+        this->m_prefix = other.m_prefix;
+        this->m_suffix = other.m_suffix;
+        this->m_between = other.m_between;
+    }
+
+    template<class TType, class TFunction>
+    SqrtTree<TType, TFunction>::SqrtTree(SqrtTree<TType, TFunction> &&other) noexcept {
+        this->m_function = std::move(other.m_function);
+        this->m_size = std::move(other.m_size);
+        this->m_lg = std::move(other.m_lg);
+        this->m_index_size = std::move(other.m_index_size);
+        this->m_row_size = std::move(other.m_row_size);
+        this->m_between_row_size = std::move(other.m_between_row_size);
+        this->m_data = std::move(other.m_data);
+        this->m_layers = std::move(other.m_layers);
+        this->m_on_layer = std::move(other.m_on_layer);
+        this->m_prefix = std::move(other.m_prefix);
+        this->m_suffix = std::move(other.m_suffix);
+        this->m_between = std::move(other.m_between);
+    }
+
+    template<class TType, class TFunction>
+    template<class TIter>
+    void SqrtTree<TType, TFunction>::build(TIter t_begin, TIter t_end) {
+        this->m_data.assign(t_begin, t_end);
+        this->m_size = this->m_data.size();
+        if (this->m_size == 0) {
+            return;
+        }
+        this->m_lg = bitWidth(this->m_size - 1);
+        this->m_on_layer.assign(this->m_lg + 1, 0);
+        for (auto lg = this->m_lg; lg > 1; lg = (lg + 1) >> 1u) {
+            this->m_on_layer[lg] = this->m_layers.size();
+            this->m_layers.push_back(lg);
+        }
+        for (auto i = this->m_lg; i > 0; --i) {
+            this->m_on_layer[i - 1] = std::max(this->m_on_layer[i - 1], this->m_on_layer[i]);
+        }
+        auto block_size_log = (this->m_lg + 1) >> 1u;
+        auto block_size = std::size_t{1} << block_size_log;
+        this->m_index_size = (this->m_size + block_size - 1) >> block_size_log;
+        this->m_row_size = this->m_size + this->m_index_size;
+        this->m_between_row_size = (std::size_t{1} << this->m_lg) + block_size;
+        this->m_data.resize(this->m_row_size);
+        this->m_prefix.resize(this->m_layers.size() * this->m_row_size);
+        this->m_suffix.resize(this->m_layers.size() * this->m_row_size);
+        if (this->m_layers.size() > 1) {
+            this->m_between.resize((this->m_layers.size() - 1) * this->m_between_row_size);
+        }
+        build(0, 0, this->m_size, 0);
+    }
+
+    template<class TType, class TFunction>
+    void SqrtTree<TType, TFunction>::buildBlock(std::size_t t_layer, std::size_t t_left, std::size_t t_right) {
+        auto prefix = this->m_prefix.begin() + t_layer * this->m_row_size;
+        auto suffix = this->m_suffix.begin() + t_layer * this->m_row_size;
+        prefix[t_left] = this->m_data[t_left];
+        for (auto i = t_left + 1; i < t_right; ++i) {
+            prefix[i] = this->m_function(prefix[i - 1], this->m_data[i]);
+        }
+        suffix[t_right - 1] = this->m_data[t_right - 1];
+        for (auto i = t_right - 1; i > t_left; --i) {
+            suffix[i - 1] = this->m_function(this->m_data[i - 1], suffix[i]);
+        }
+    }
+
+    template<class TType, class TFunction>
+    void SqrtTree<TType, TFunction>::buildBetween(std::size_t t_layer, std::size_t t_left_bound,
+                                                  std::size_t t_right_bound, std::size_t t_between_offset) {
+        auto block_size_log = (this->m_layers[t_layer] + 1) >> 1u;
+        auto block_count_log = this->m_layers[t_layer] >> 1u;
+        auto block_size = std::size_t{1} << block_size_log;
+        auto block_count = (t_right_bound - t_left_bound + block_size - 1) >> block_size_log;
+        auto suffix = this->m_suffix.begin() + t_layer * this->m_row_size;
+        auto between = this->m_between.begin() + (t_layer - 1) * this->m_between_row_size + t_between_offset +
+                       t_left_bound;
+        for (std::size_t i = 0; i < block_count; ++i) {
+            auto value = suffix[t_left_bound + (i << block_size_log)];
+            between[(i << block_count_log) + i] = value;
+            for (auto j = i + 1; j < block_count; ++j) {
+                value = this->m_function(value, suffix[t_left_bound + (j << block_size_log)]);
+                between[(i << block_count_log) + j] = value;
+            }
+        }
+    }
+
+    template<class TType, class TFunction>
+    void SqrtTree<TType, TFunction>::buildBetweenZero() {
+        auto block_size_log = (this->m_lg + 1) >> 1u;
+        for (std::size_t i = 0; i < this->m_index_size; ++i) {
+            this->m_data[this->m_size + i] = this->m_suffix[i << block_size_log];
+        }
+        build(1, this->m_size, this->m_row_size, (std::size_t{1} << this->m_lg) - this->m_size);
+    }
+
+    template<class TType, class TFunction>
+    void SqrtTree<TType, TFunction>::updateBetweenZero(std::size_t t_block) {
+        auto block_size_log = (this->m_lg + 1) >> 1u;
+        this->m_data[this->m_size + t_block] = this->m_suffix[t_block << block_size_log];
+        update(1, this->m_size, this->m_row_size, (std::size_t{1} << this->m_lg) - this->m_size,
+               this->m_size + t_block);
+    }
+
+    template<class TType, class TFunction>
+    void SqrtTree<TType, TFunction>::build(std::size_t t_layer, std::size_t t_left_bound, std::size_t t_right_bound,
+                                           std::size_t t_between_offset) {
+        if (t_layer >= this->m_layers.size()) {
+            return;
+        }
+        auto block_size = std::size_t{1} << ((this->m_layers[t_layer] + 1) >> 1u);
+        for (auto l = t_left_bound; l < t_right_bound; l += block_size) {
+            auto r = std::min(l + block_size, t_right_bound);
+            buildBlock(t_layer, l, r);
+            build(t_layer + 1, l, r, t_between_offset);
+        }
+        if (t_layer == 0) {
+            buildBetweenZero();
+        } else {
+            buildBetween(t_layer, t_left_bound, t_right_bound, t_between_offset);
+        }
+    }
+
+    template<class TType, class TFunction>
+    void SqrtTree<TType, TFunction>::update(std::size_t t_layer, std::size_t t_left_bound, std::size_t t_right_bound,
+                                            std::size_t t_between_offset, std::size_t t_index) {
+        if (t_layer >= this->m_layers.size()) {
+            return;
+        }
+        auto block_size_log = (this->m_layers[t_layer] + 1) >> 1u;
+        auto block = (t_index - t_left_bound) >> block_size_log;
+        auto l = t_left_bound + (block << block_size_log);
+        auto r = std::min(l + (std::size_t{1} << block_size_log), t_right_bound);
+        buildBlock(t_layer, l, r);
+        if (t_layer == 0) {
+            updateBetweenZero(block);
+        } else {
+            buildBetween(t_layer, t_left_bound, t_right_bound, t_between_offset);
+        }
+        update(t_layer + 1, l, r, t_between_offset, t_index);
+    }
+
+    template<class TType, class TFunction>
+    const TType &SqrtTree<TType, TFunction>::getValueAt(std::size_t t_index) const {
+        return this->m_data[t_index];
+    }
+
+    template<class TType, class TFunction>
+    void SqrtTree<TType, TFunction>::changeValueAt(std::size_t t_index, const TType &t_value) {
+        this->m_data[t_index] = t_value;
+        update(0, 0, this->m_size, 0, t_index);
+    }
+
+    template<class TType, class TFunction>
+    TType SqrtTree<TType, TFunction>::valueOnSegment(std::size_t t_left_index, std::size_t t_right_index) const {
+        return valueOnSegment(t_left_index, t_right_index, 0, 0);
+    }
+
+    template<class TType, class TFunction>
+    TType SqrtTree<TType, TFunction>::valueOnSegment(std::size_t t_left_index, std::size_t t_right_index,
+                                                     std::size_t t_between_offset, std::size_t t_base) const {
+        if (t_left_index == t_right_index) {
+            return this->m_data[t_left_index];
+        }
+        if (t_left_index + 1 == t_right_index) {
+            return this->m_function(this->m_data[t_left_index], this->m_data[t_right_index]);
+        }
+        auto layer = this->m_on_layer[bitWidth((t_left_index - t_base) ^ (t_right_index - t_base))];
+        auto block_size_log = (this->m_layers[layer] + 1) >> 1u;
+        auto block_count_log = this->m_layers[layer] >> 1u;
+        auto left_bound = (((t_left_index - t_base) >> this->m_layers[layer]) << this->m_layers[layer]) + t_base;
+        auto left_block = ((t_left_index - left_bound) >> block_size_log) + 1;
+        auto right_block = (t_right_index - left_bound) >> block_size_log;
+        auto result = this->m_suffix[layer * this->m_row_size + t_left_index];
+        if (left_block < right_block) {
+            if (layer == 0) {
+                result = this->m_function(result, valueOnSegment(
+                        this->m_size + left_block, this->m_size + right_block - 1,
+                        (std::size_t{1} << this->m_lg) - this->m_size, this->m_size));
+            } else {
+                result = this->m_function(result, this->m_between[
+                        (layer - 1) * this->m_between_row_size + t_between_offset + left_bound +
+                        (left_block << block_count_log) + right_block - 1]);
+            }
+        }
+        return this->m_function(result, this->m_prefix[layer * this->m_row_size + t_right_index]);
+    }
+
+}
+
+#endif //COMPETITIVE_ALGORITHMS_SQRTTREE_H
@@ -0,0 +1,250 @@
+#ifndef COMPETITIVE_ALGORITHMS_STATS_H
+#define COMPETITIVE_ALGORITHMS_STATS_H
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "Monoid.h"
+
+namespace cpa {
+
+    struct Stats {
+        std::atomic<std::size_t> combines{0};
+        std::atomic<std::size_t> visits{0};
+        std::atomic<std::size_t> allocated_bytes{0};
+        std::atomic<std::size_t> rebuilds{0};
+
+        void reset() noexcept;
+    };
+
+    class StatsRegistry {
+    private:
+        static constexpr std::size_t min_prune_size = 64;
+
+        mutable std::mutex m_mutex;
+        mutable std::vector<std::pair<std::string, std::weak_ptr<Stats>>> m_entries;
+        std::size_t m_prune_size = min_prune_size;
+
+        StatsRegistry() = default;
+
+        void prune() const;
+
+    public:
+        static StatsRegistry &instance();
+
+        void add(const std::string &t_name, const std::shared_ptr<Stats> &t_stats);
+
+        void dump(std::ostream &t_out) const;
+
+        [[nodiscard]] std::size_t size() const;
+    };
+
+    struct NoStats {
+        static constexpr bool stats_enabled = false;
+
+        void combine() const noexcept;
+
+        void visit(std::size_t = 1) const noexcept;
+
+        void allocate(std::size_t) const noexcept;
+
+        void rebuild() const noexcept;
+    };
+
+    class CountingStats {
+    private:
+        std::shared_ptr<Stats> m_stats;
+
+    public:
+        static constexpr bool stats_enabled = true;
+
+        explicit CountingStats(const std::string &t_name = "unnamed");
+
+        [[nodiscard]] const Stats &stats() const noexcept;
+
+        void reset() const noexcept;
+
+        void combine() const noexcept;
+
+        void visit(std::size_t t_count = 1) const noexcept;
+
+        void allocate(std::size_t t_bytes) const noexcept;
+
+        void rebuild() const noexcept;
+    };
+
+    inline void Stats::reset() noexcept {
+        this->combines = 0;
+        this->visits = 0;
+        this->allocated_bytes = 0;
+        this->rebuilds = 0;
+    }
+
+    inline StatsRegistry &StatsRegistry::instance() {
+        static StatsRegistry registry;
+        return registry;
+    }
+
+    inline void StatsRegistry::prune() const {
+        this->m_entries.erase(std::remove_if(this->m_entries.begin(), this->m_entries.end(), [](const auto &entry) {
+            return entry.second.expired();
+        }), this->m_entries.end());
+    }
+
+    inline void StatsRegistry::add(const std::string &t_name, const std::shared_ptr<Stats> &t_stats) {
+        std::lock_guard<std::mutex> lock(this->m_mutex);
+        if (this->m_entries.size() >= this->m_prune_size) {
+            this->prune();
+            this->m_prune_size = std::max(min_prune_size, this->m_entries.size() * 2);
+        }
+        this->m_entries.emplace_back(t_name, t_stats);
+    }
+
+    inline void StatsRegistry::dump(std::ostream &t_out) const {
+        std::lock_guard<std::mutex> lock(this->m_mutex);
+        this->prune();
+        t_out << "[";
+        bool first = true;
+        for (auto &entry : this->m_entries) {
+            auto stats = entry.second.lock();
+            if (!stats) {
+                continue;
+            }
+            t_out << (first ? "" : ",") << "\n  {\"name\": \"" << entry.first << "\""
+                  << ", \"combines\": " << stats->combines
+                  << ", \"visits\": " << stats->visits
+                  << ", \"allocated_bytes\": " << stats->allocated_bytes
+                  << ", \"rebuilds\": " << stats->rebuilds << "}";
+            first = false;
+        }
+        t_out << "\n]" << std::endl;
+    }
+
+    inline std::size_t StatsRegistry::size() const {
+        std::lock_guard<std::mutex> lock(this->m_mutex);
+        return this->m_entries.size();
+    }
+
+    inline void NoStats::combine() const noexcept {}
+
+    inline void NoStats::visit(std::size_t) const noexcept {}
+
+    inline void NoStats::allocate(std::size_t) const noexcept {}
+
+    inline void NoStats::rebuild() const noexcept {}
+
+    inline CountingStats::CountingStats(const std::string &t_name) : m_stats(std::make_shared<Stats>()) {
+        StatsRegistry::instance().add(t_name, this->m_stats);
+    }
+
+    inline const Stats &CountingStats::stats() const noexcept {
+        return *this->m_stats;
+    }
+
+    inline void CountingStats::reset() const noexcept {
+        this->m_stats->reset();
+    }
+
+    inline void CountingStats::combine() const noexcept {
+        this->m_stats->combines.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    inline void CountingStats::visit(std::size_t t_count) const noexcept {
+        this->m_stats->visits.fetch_add(t_count, std::memory_order_relaxed);
+    }
+
+    inline void CountingStats::allocate(std::size_t t_bytes) const noexcept {
+        this->m_stats->allocated_bytes.fetch_add(t_bytes, std::memory_order_relaxed);
+    }
+
+    inline void CountingStats::rebuild() const noexcept {
+        this->m_stats->rebuilds.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    template<class TPolicy, class = void>
+    struct StatsTraits {
+        static constexpr bool enabled = false;
+    };
+
+    template<class TPolicy>
+    struct StatsTraits<TPolicy, std::void_t<decltype(TPolicy::stats_enabled)>> {
+        static constexpr bool enabled = TPolicy::stats_enabled;
+    };
+
+    template<class TPolicy, class... TContainers>
+    void countAllocation(const TPolicy &t_policy, const TContainers &... t_containers) noexcept {
+        if constexpr (StatsTraits<TPolicy>::enabled) {
+            t_policy.allocate((std::size_t{0} + ... +
+                               (t_containers.size() * sizeof(typename TContainers::value_type))));
+        }
+    }
+
+    template<class TPolicy, class... TContainers>
+    void countRebuild(const TPolicy &t_policy, const TContainers &... t_containers) noexcept {
+        if constexpr (StatsTraits<TPolicy>::enabled) {
+            t_policy.rebuild();
+            countAllocation(t_policy, t_containers...);
+        }
+    }
+
+    template<class TPolicy>
+    void countVisits(const TPolicy &t_policy, std::size_t t_count) noexcept {
+        if constexpr (StatsTraits<TPolicy>::enabled) {
+            t_policy.visit(t_count);
+        }
+    }
+
+    template<class TFunction, class TStats = CountingStats>
+    class Instrumented : public TStats {
+    private:
+        TFunction m_function;
+
+    public:
+        static constexpr bool idempotent = MonoidTraits<TFunction>::idempotent;
+        static constexpr bool commutative = MonoidTraits<TFunction>::commutative;
+        static constexpr bool invertible = MonoidTraits<TFunction>::invertible;
+
+        explicit Instrumented(const TStats &t_stats = TStats(), const TFunction &t_function = TFunction());
+
+        template<class TPolicy = TFunction>
+        static constexpr auto identity() noexcept -> decltype(TPolicy::identity());
+
+        template<class TType, class TPolicy = TFunction>
+        static constexpr auto inverse(const TType &a) -> decltype(TPolicy::inverse(a));
+
+        template<class TType>
+        auto operator()(const TType &a, const TType &b) const;
+    };
+
+    template<class TFunction, class TStats>
+    Instrumented<TFunction, TStats>::Instrumented(const TStats &t_stats, const TFunction &t_function) :
+            TStats(t_stats), m_function(t_function) {}
+
+    template<class TFunction, class TStats>
+    template<class TPolicy>
+    constexpr auto Instrumented<TFunction, TStats>::identity() noexcept -> decltype(TPolicy::identity()) {
+        return TPolicy::identity();
+    }
+
+    template<class TFunction, class TStats>
+    template<class TType, class TPolicy>
+    constexpr auto Instrumented<TFunction, TStats>::inverse(const TType &a) -> decltype(TPolicy::inverse(a)) {
+        return TPolicy::inverse(a);
+    }
+
+    template<class TFunction, class TStats>
+    template<class TType>
+    auto Instrumented<TFunction, TStats>::operator()(const TType &a, const TType &b) const {
+        this->combine();
+        return this->m_function(a, b);
+    }
+
+}
+
+#endif //COMPETITIVE_ALGORITHMS_STATS_H
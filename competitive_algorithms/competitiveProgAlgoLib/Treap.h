@@ -3,8 +3,11 @@
 
 #include <random>
 #include <chrono>
+#include <cstdint>
+#include <limits>
 #include <memory>
-#include <stack>
+#include <tuple>
+#include <vector>
 #include "IMutableDataStructure.h"
 #include "ISegmentSolver.h"
 
@@ -12,216 +15,626 @@ namespace cpa {
 
     template<class TType, class TFunction = std::function<TType(const TType &, const TType &)>>
     class Treap :
-            public IMutableDataStructure<TType>,
-            public ISegmentSolver<TType, TFunction> {
+            public IMutableDataStructure<Treap<TType, TFunction>, TType>,
+            public ISegmentSolver<Treap<TType, TFunction>, TType, TFunction> {
     private:
-        std::mt19937 m_rnd;
-        TFunction m_function;
+        using index_type = std::uint32_t;
+
+        static constexpr index_type null_node = std::numeric_limits<index_type>::max();
+
+        static constexpr bool keep_reversed_value = !MonoidTraits<TFunction>::commutative;
 
         struct node {
-            std::size_t size;
+            index_type references;
+            index_type size;
             unsigned int prior;
+            index_type left;
+            index_type right;
+            bool reversed;
             TType value;
             TType segmentValue;
-            std::unique_ptr<node> left, right;
+            TType reversedSegmentValue;
 
             explicit node(const TType &value, unsigned int prior) :
+                    references(1),
                     size(1),
                     prior(prior),
+                    left(null_node),
+                    right(null_node),
+                    reversed(false),
                     value(value),
                     segmentValue(value),
-                    left(nullptr),
-                    right(nullptr) {}
-
-            node(const node &other) :
-                    size(other.size),
-                    prior(other.prior),
-                    value(other.value),
-                    segmentValue(other.segmentValue),
-                    left(other->left == nullptr ? nullptr : std::make_unique<node>(*other->left)),
-                    right(other->right == nullptr ? nullptr : std::make_unique<node>(*other->right)) {}
-
-            void update(const TFunction &t_function);
+                    reversedSegmentValue(value) {}
         };
 
+        // Copies share one pool whose node storage reallocates and whose reference counts are plain integers,
+        // so every Treap forked from the same source must be used from a single thread at a time.
+        struct pool {
+            std::mt19937 rnd;
+            std::vector<node> nodes;
+            std::vector<index_type> free;
+        };
+
+        std::shared_ptr<pool> m_pool;
+        std::vector<index_type> m_path;
+        index_type m_root = null_node;
+
+        Treap(std::shared_ptr<pool> t_pool, index_type t_root, const TFunction &t_function);
+
         void initial_random();
 
         template<class TIter>
-        void build(TIter t_begin, TIter t_end);
+        index_type build(TIter t_begin, TIter t_end);
 
-        const TType &getValueAt(const std::unique_ptr<node> &t_current, std::size_t t_index) const;
+        index_type createNode(const TType &t_value);
 
-        void changeValueAt(std::unique_ptr<node> &t_current, std::size_t t_index, const TType &t_value);
+        void retain(index_type t_node);
 
-        TType
-        valueOnSegment(const std::unique_ptr<node> &t_current, std::size_t t_left_index,
-                       std::size_t t_right_index) const;
+        void release(index_type t_node);
 
-    public:
-        std::unique_ptr<node> m_root = nullptr;
+        index_type detach(index_type t_node);
+
+        [[nodiscard]] const TType &segmentValue(index_type t_node, bool t_flipped) const;
+
+        [[nodiscard]] std::pair<index_type, index_type> children(index_type t_node, bool t_flipped) const;
+
+        [[nodiscard]] std::size_t nodeSize(index_type t_node) const noexcept;
+
+        void update(index_type t_node);
+
+        void toggleReversed(index_type t_node);
+
+        void push(index_type t_node);
+
+        void splitNodes(index_type t_node, std::size_t t_count, index_type &t_left, index_type &t_right);
+
+        index_type mergeNodes(index_type t_left, index_type t_right);
+
+        void collectValues(std::vector<TType> &t_values) const;
+
+        TType suffixValue(index_type t_node, bool t_flipped, std::size_t t_left_index) const;
+
+        TType prefixValue(index_type t_node, bool t_flipped, std::size_t t_right_index) const;
 
-        explicit Treap(const TFunction &t_function = nullptr);
+    public:
+        explicit Treap(const TFunction &t_function = TFunction());
 
         template<class TIter>
-        Treap(TIter t_begin, TIter t_end, const TFunction &t_function = nullptr);
+        Treap(TIter t_begin, TIter t_end, const TFunction &t_function = TFunction());
 
         Treap(const Treap<TType, TFunction> &other);
 
         Treap(Treap<TType, TFunction> &&other) noexcept;
 
-        const TType &getValueAt(std::size_t t_index) const override;
+        ~Treap();
 
-        void changeValueAt(std::size_t t_index, const TType &t_value) override;
+        const TType &getValueAt(std::size_t t_index) const;
 
-        TType valueOnSegment(std::size_t t_left_index, std::size_t t_right_index) const override;
-    };
+        void changeValueAt(std::size_t t_index, const TType &t_value);
 
-    template<class TType, class TFunction>
-    void Treap<TType, TFunction>::node::update(const TFunction &t_function) {
-        this->size = 1;
-        this->segmentValue = this->value;
-        if (this->left != nullptr) {
-            this->size += this->left->size;
-            this->segmentValue = t_function(this->segmentValue, this->left->segmentValue);
-        }
-        if (this->right != nullptr) {
-            this->size += this->right->size;
-            this->segmentValue = t_function(this->segmentValue, this->right->segmentValue);
-        }
-    }
+        TType valueOnSegment(std::size_t t_left_index, std::size_t t_right_index) const;
+
+        void insertAt(std::size_t t_index, const TType &t_value);
+
+        void eraseAt(std::size_t t_index);
+
+        Treap<TType, TFunction> split(std::size_t t_count);
+
+        void merge(Treap<TType, TFunction> &&other);
+
+        void reverseSegment(std::size_t t_left_index, std::size_t t_right_index);
+
+        void cyclicShift(std::size_t t_left_index, std::size_t t_right_index, std::size_t t_shift);
+    };
 
     template<class TType, class TFunction>
-    Treap<TType, TFunction>::Treap(const TFunction &t_function) {
+    Treap<TType, TFunction>::Treap(const TFunction &t_function) : m_pool(std::make_shared<pool>()) {
         this->m_function = t_function;
-        this->m_root = nullptr;
         initial_random();
         this->m_size = 0;
     }
 
     template<class TType, class TFunction>
     template<class TIter>
-    Treap<TType, TFunction>::Treap(TIter t_begin, TIter t_end, const TFunction &t_function) {
+    Treap<TType, TFunction>::Treap(TIter t_begin, TIter t_end, const TFunction &t_function) :
+            m_pool(std::make_shared<pool>()) {
         this->m_function = t_function;
         initial_random();
-        build(t_begin, t_end);
-        this->m_size = this->m_root == nullptr ? 0 : this->m_root->size;
+        this->m_pool->nodes.reserve(std::distance(t_begin, t_end));
+        this->m_root = build(t_begin, t_end);
+        this->m_size = nodeSize(this->m_root);
     }
 
     template<class TType, class TFunction>
-    Treap<TType, TFunction>::Treap(const Treap<TType, TFunction> &other) {
+    Treap<TType, TFunction>::Treap(std::shared_ptr<pool> t_pool, index_type t_root, const TFunction &t_function) :
+            m_pool(std::move(t_pool)),
+            m_root(t_root) {
+        this->m_function = t_function;
+        this->m_size = nodeSize(this->m_root);
+    }
+
+    template<class TType, class TFunction>
+    Treap<TType, TFunction>::Treap(const Treap<TType, TFunction> &other) :
+            m_pool(other.m_pool),
+            m_root(other.m_root) {
         this->m_function = other.m_function;
-        this->m_rnd = other.m_rnd;
         this->m_size = other.m_size;
-        this->m_root = other.m_root == nullptr ? nullptr : std::make_unique<node>(*other.m_root);
+        retain(this->m_root);
     }
 
     template<class TType, class TFunction>
     Treap<TType, TFunction>::Treap(Treap<TType, TFunction> &&other) noexcept {
         this->m_function = std::move(other.m_function);
-        this->m_rnd = std::move(other.m_rnd);
         this->m_size = std::move(other.m_size);
+        this->m_pool = std::move(other.m_pool);
         this->m_root = std::move(other.m_root);
+        other.m_root = null_node;
+        other.m_size = 0;
+    }
+
+    template<class TType, class TFunction>
+    Treap<TType, TFunction>::~Treap() {
+        if (this->m_pool && this->m_pool.use_count() > 1) {
+            release(this->m_root);
+        }
     }
 
     template<class TType, class TFunction>
     template<class TIter>
-    void Treap<TType, TFunction>::build(TIter t_begin, TIter t_end) {
-        std::stack<std::unique_ptr<node>> st;
-        st.push(std::make_unique<node>(*t_begin++, this->m_rnd()));
+    typename Treap<TType, TFunction>::index_type Treap<TType, TFunction>::build(TIter t_begin, TIter t_end) {
+        auto &nodes = this->m_pool->nodes;
+        std::vector<index_type> st;
+        index_type root = null_node;
         for (auto it = t_begin; it != t_end; ++it) {
-            auto new_node = std::make_unique<node>(*it, this->m_rnd());
-            while (!st.empty() && new_node->prior < st.top()->prior) {
-                st.top()->right = std::move(new_node->left);
-                st.top()->update(this->m_function);
-                new_node->left = std::move(st.top());
-                st.pop();
+            auto new_node = createNode(*it);
+            index_type last = null_node;
+            while (!st.empty() && nodes[new_node].prior < nodes[st.back()].prior) {
+                last = st.back();
+                update(last);
+                st.pop_back();
             }
-            st.push(std::move(new_node));
+            nodes[new_node].left = last;
+            if (!st.empty()) {
+                nodes[st.back()].right = new_node;
+            }
+            st.push_back(new_node);
         }
-        while (st.size() > 1) {
-            auto current_node = std::move(st.top());
-            current_node->update(this->m_function);
-            st.pop();
-            st.top()->right = std::move(current_node);
+        while (!st.empty()) {
+            update(st.back());
+            root = st.back();
+            st.pop_back();
         }
-        this->m_root = std::move(st.top());
-        this->m_root->update(this->m_function);
+        return root;
     }
 
     template<class TType, class TFunction>
-    void Treap<TType, TFunction>::initial_random() {
-        this->m_rnd.seed(std::chrono::steady_clock::now().time_since_epoch().count());
+    typename Treap<TType, TFunction>::index_type Treap<TType, TFunction>::createNode(const TType &t_value) {
+        auto &current_pool = *this->m_pool;
+        if (!current_pool.free.empty()) {
+            auto result = current_pool.free.back();
+            current_pool.free.pop_back();
+            current_pool.nodes[result] = node(t_value, current_pool.rnd());
+            return result;
+        }
+        current_pool.nodes.emplace_back(t_value, current_pool.rnd());
+        return static_cast<index_type>(current_pool.nodes.size() - 1);
     }
 
     template<class TType, class TFunction>
-    const TType &Treap<TType, TFunction>::getValueAt(std::size_t t_index) const {
-        return getValueAt(this->m_root, t_index);
+    void Treap<TType, TFunction>::retain(index_type t_node) {
+        if (t_node != null_node) {
+            ++this->m_pool->nodes[t_node].references;
+        }
     }
 
     template<class TType, class TFunction>
-    void Treap<TType, TFunction>::changeValueAt(std::size_t t_index, const TType &t_value) {
-        changeValueAt(this->m_root, t_index, t_value);
+    void Treap<TType, TFunction>::release(index_type t_node) {
+        auto &current_pool = *this->m_pool;
+        std::vector<index_type> st;
+        if (t_node != null_node) {
+            st.push_back(t_node);
+        }
+        while (!st.empty()) {
+            auto &current = current_pool.nodes[st.back()];
+            if (--current.references != 0) {
+                st.pop_back();
+                continue;
+            }
+            current_pool.free.push_back(st.back());
+            st.pop_back();
+            if (current.left != null_node) {
+                st.push_back(current.left);
+            }
+            if (current.right != null_node) {
+                st.push_back(current.right);
+            }
+        }
     }
 
     template<class TType, class TFunction>
-    TType Treap<TType, TFunction>::valueOnSegment(std::size_t t_left_index, std::size_t t_right_index) const {
-        return valueOnSegment(this->m_root, t_left_index, t_right_index);
+    typename Treap<TType, TFunction>::index_type Treap<TType, TFunction>::detach(index_type t_node) {
+        if (t_node == null_node || this->m_pool->nodes[t_node].references == 1) {
+            return t_node;
+        }
+        auto &current_pool = *this->m_pool;
+        --current_pool.nodes[t_node].references;
+        node copy = current_pool.nodes[t_node];
+        copy.references = 1;
+        retain(copy.left);
+        retain(copy.right);
+        if (!current_pool.free.empty()) {
+            auto result = current_pool.free.back();
+            current_pool.free.pop_back();
+            current_pool.nodes[result] = std::move(copy);
+            return result;
+        }
+        current_pool.nodes.push_back(std::move(copy));
+        return static_cast<index_type>(current_pool.nodes.size() - 1);
     }
 
     template<class TType, class TFunction>
-    const TType &
-    Treap<TType, TFunction>::getValueAt(const std::unique_ptr<node> &t_current, std::size_t t_index) const {
-        std::size_t left_size = t_current->left == nullptr ? 0 : t_current->left->size;
-        if (left_size == t_index) {
-            return t_current->value;
+    const TType &Treap<TType, TFunction>::segmentValue(index_type t_node, bool t_flipped) const {
+        auto &current = this->m_pool->nodes[t_node];
+        if constexpr (keep_reversed_value) {
+            return t_flipped ? current.reversedSegmentValue : current.segmentValue;
         }
-        if (left_size > t_index) {
-            return getValueAt(t_current->left, t_index);
-        } else {
-            return getValueAt(t_current->right, t_index - left_size - 1);
+        return current.segmentValue;
+    }
+
+    template<class TType, class TFunction>
+    std::pair<typename Treap<TType, TFunction>::index_type, typename Treap<TType, TFunction>::index_type>
+    Treap<TType, TFunction>::children(index_type t_node, bool t_flipped) const {
+        auto &current = this->m_pool->nodes[t_node];
+        if (t_flipped != current.reversed) {
+            return {current.right, current.left};
+        }
+        return {current.left, current.right};
+    }
+
+    template<class TType, class TFunction>
+    std::size_t Treap<TType, TFunction>::nodeSize(index_type t_node) const noexcept {
+        return t_node == null_node ? 0 : this->m_pool->nodes[t_node].size;
+    }
+
+    template<class TType, class TFunction>
+    void Treap<TType, TFunction>::update(index_type t_node) {
+        auto &nodes = this->m_pool->nodes;
+        auto &current = nodes[t_node];
+        current.size = 1;
+        current.segmentValue = current.value;
+        if constexpr (keep_reversed_value) {
+            current.reversedSegmentValue = current.value;
+        }
+        if (current.left != null_node) {
+            auto &left = nodes[current.left];
+            current.size += left.size;
+            current.segmentValue = this->m_function(left.segmentValue, current.segmentValue);
+            if constexpr (keep_reversed_value) {
+                current.reversedSegmentValue = this->m_function(current.reversedSegmentValue,
+                                                                left.reversedSegmentValue);
+            }
+        }
+        if (current.right != null_node) {
+            auto &right = nodes[current.right];
+            current.size += right.size;
+            current.segmentValue = this->m_function(current.segmentValue, right.segmentValue);
+            if constexpr (keep_reversed_value) {
+                current.reversedSegmentValue = this->m_function(right.reversedSegmentValue,
+                                                                current.reversedSegmentValue);
+            }
         }
     }
 
     template<class TType, class TFunction>
-    void
-    Treap<TType, TFunction>::changeValueAt(std::unique_ptr<node> &t_current, std::size_t t_index,
-                                           const TType &t_value) {
-        std::size_t left_size = t_current->left == nullptr ? 0 : t_current->left->size;
-        if (left_size == t_index) {
-            t_current->value = t_value;
-        } else if (left_size > t_index) {
-            changeValueAt(t_current->left, t_index, t_value);
+    void Treap<TType, TFunction>::toggleReversed(index_type t_node) {
+        if (t_node == null_node) {
+            return;
+        }
+        auto &current = this->m_pool->nodes[t_node];
+        current.reversed = !current.reversed;
+        if constexpr (keep_reversed_value) {
+            std::swap(current.segmentValue, current.reversedSegmentValue);
+        }
+    }
+
+    template<class TType, class TFunction>
+    void Treap<TType, TFunction>::push(index_type t_node) {
+        auto &nodes = this->m_pool->nodes;
+        if (!nodes[t_node].reversed) {
+            return;
+        }
+        auto left = detach(nodes[t_node].left);
+        auto right = detach(nodes[t_node].right);
+        toggleReversed(left);
+        toggleReversed(right);
+        nodes[t_node].left = right;
+        nodes[t_node].right = left;
+        nodes[t_node].reversed = false;
+    }
+
+    template<class TType, class TFunction>
+    void Treap<TType, TFunction>::splitNodes(index_type t_node, std::size_t t_count,
+                                             index_type &t_left, index_type &t_right) {
+        if (t_node == null_node) {
+            t_left = t_right = null_node;
+            return;
+        }
+        t_node = detach(t_node);
+        push(t_node);
+        auto &nodes = this->m_pool->nodes;
+        auto left_size = nodeSize(nodes[t_node].left);
+        index_type left, right;
+        if (t_count <= left_size) {
+            splitNodes(nodes[t_node].left, t_count, left, right);
+            nodes[t_node].left = right;
+            t_left = left;
+            t_right = t_node;
         } else {
-            changeValueAt(t_current->right, t_index - left_size - 1, t_value);
+            splitNodes(nodes[t_node].right, t_count - left_size - 1, left, right);
+            nodes[t_node].right = left;
+            t_left = t_node;
+            t_right = right;
+        }
+        update(t_node);
+    }
+
+    template<class TType, class TFunction>
+    typename Treap<TType, TFunction>::index_type
+    Treap<TType, TFunction>::mergeNodes(index_type t_left, index_type t_right) {
+        if (t_left == null_node) {
+            return t_right;
+        }
+        if (t_right == null_node) {
+            return t_left;
+        }
+        auto &nodes = this->m_pool->nodes;
+        if (nodes[t_left].prior < nodes[t_right].prior) {
+            t_left = detach(t_left);
+            push(t_left);
+            auto right = mergeNodes(nodes[t_left].right, t_right);
+            nodes[t_left].right = right;
+            update(t_left);
+            return t_left;
         }
-        t_current->update(this->m_function);
+        t_right = detach(t_right);
+        push(t_right);
+        auto left = mergeNodes(t_left, nodes[t_right].left);
+        nodes[t_right].left = left;
+        update(t_right);
+        return t_right;
+    }
+
+    template<class TType, class TFunction>
+    void Treap<TType, TFunction>::collectValues(std::vector<TType> &t_values) const {
+        auto &nodes = this->m_pool->nodes;
+        t_values.reserve(t_values.size() + this->m_size);
+        std::vector<std::pair<index_type, bool>> st;
+        auto current = this->m_root;
+        auto flipped = false;
+        while (current != null_node || !st.empty()) {
+            while (current != null_node) {
+                st.emplace_back(current, flipped);
+                auto left = children(current, flipped).first;
+                flipped = flipped != nodes[current].reversed;
+                current = left;
+            }
+            std::tie(current, flipped) = st.back();
+            st.pop_back();
+            t_values.push_back(nodes[current].value);
+            auto right = children(current, flipped).second;
+            flipped = flipped != nodes[current].reversed;
+            current = right;
+        }
+    }
+
+    template<class TType, class TFunction>
+    void Treap<TType, TFunction>::initial_random() {
+        this->m_pool->rnd.seed(std::chrono::steady_clock::now().time_since_epoch().count());
     }
 
     template<class TType, class TFunction>
-    TType Treap<TType, TFunction>::valueOnSegment(const std::unique_ptr<node> &t_current, std::size_t t_left_index,
-                                                  std::size_t t_right_index) const {
-        if (t_left_index == 0 && t_right_index + 1 == t_current->size) {
-            return t_current->segmentValue;
+    const TType &Treap<TType, TFunction>::getValueAt(std::size_t t_index) const {
+        auto current = this->m_root;
+        auto flipped = false;
+        while (true) {
+            auto [left, right] = children(current, flipped);
+            flipped = flipped != this->m_pool->nodes[current].reversed;
+            auto left_size = nodeSize(left);
+            if (left_size == t_index) {
+                return this->m_pool->nodes[current].value;
+            }
+            if (left_size > t_index) {
+                current = left;
+            } else {
+                t_index -= left_size + 1;
+                current = right;
+            }
         }
-        std::size_t left_size = t_current->left == nullptr ? 0 : t_current->left->size;
-        bool left_has = t_current->left != nullptr && t_left_index < left_size;
-        bool current_has = t_left_index <= left_size && left_size <= t_right_index;
-        bool right_has = t_current->right != nullptr && left_size + 1 <= t_right_index;
-        if (!current_has){
-            if (left_has){
-                return valueOnSegment(t_current->left, t_left_index, t_right_index);
+    }
+
+    template<class TType, class TFunction>
+    void Treap<TType, TFunction>::changeValueAt(std::size_t t_index, const TType &t_value) {
+        auto &nodes = this->m_pool->nodes;
+        this->m_path.clear();
+        this->m_root = detach(this->m_root);
+        auto current = this->m_root;
+        while (true) {
+            push(current);
+            this->m_path.push_back(current);
+            auto left_size = nodeSize(nodes[current].left);
+            if (left_size == t_index) {
+                nodes[current].value = t_value;
+                break;
+            }
+            if (left_size > t_index) {
+                auto left = detach(nodes[current].left);
+                nodes[current].left = left;
+                current = left;
             } else {
-                return valueOnSegment(t_current->right, t_left_index - left_size - 1, t_right_index - left_size - 1);
+                t_index -= left_size + 1;
+                auto right = detach(nodes[current].right);
+                nodes[current].right = right;
+                current = right;
             }
         }
-        auto result = t_current->value;
-        if (left_has) {
-            result = this->m_function(result, valueOnSegment(t_current->left, t_left_index, left_size - 1));
+        for (auto it = this->m_path.rbegin(); it != this->m_path.rend(); ++it) {
+            update(*it);
         }
-        if (right_has) {
-            result = this->m_function(result, valueOnSegment(t_current->right, 0, t_right_index - left_size - 1));
+    }
+
+    template<class TType, class TFunction>
+    TType Treap<TType, TFunction>::valueOnSegment(std::size_t t_left_index, std::size_t t_right_index) const {
+        auto &nodes = this->m_pool->nodes;
+        auto current = this->m_root;
+        auto flipped = false;
+        while (true) {
+            if (t_left_index == 0 && t_right_index + 1 == nodes[current].size) {
+                return segmentValue(current, flipped);
+            }
+            auto [left, right] = children(current, flipped);
+            flipped = flipped != nodes[current].reversed;
+            auto left_size = nodeSize(left);
+            if (t_right_index < left_size) {
+                current = left;
+            } else if (t_left_index > left_size) {
+                t_left_index -= left_size + 1;
+                t_right_index -= left_size + 1;
+                current = right;
+            } else {
+                auto result = nodes[current].value;
+                if (t_left_index < left_size) {
+                    result = this->m_function(suffixValue(left, flipped, t_left_index), result);
+                }
+                if (t_right_index > left_size) {
+                    result = this->m_function(result, prefixValue(right, flipped, t_right_index - left_size - 1));
+                }
+                return result;
+            }
+        }
+    }
+
+    template<class TType, class TFunction>
+    TType Treap<TType, TFunction>::suffixValue(index_type t_node, bool t_flipped, std::size_t t_left_index) const {
+        auto &nodes = this->m_pool->nodes;
+        TType result{};
+        bool has_result = false;
+        while (true) {
+            if (t_left_index == 0) {
+                auto &segment_value = segmentValue(t_node, t_flipped);
+                return has_result ? this->m_function(segment_value, result) : segment_value;
+            }
+            auto [left, right] = children(t_node, t_flipped);
+            t_flipped = t_flipped != nodes[t_node].reversed;
+            auto left_size = nodeSize(left);
+            if (t_left_index <= left_size) {
+                auto &value = nodes[t_node].value;
+                auto piece = right == null_node ? value : this->m_function(value, segmentValue(right, t_flipped));
+                result = has_result ? this->m_function(piece, result) : piece;
+                has_result = true;
+                if (t_left_index == left_size) {
+                    return result;
+                }
+                t_node = left;
+            } else {
+                t_left_index -= left_size + 1;
+                t_node = right;
+            }
+        }
+    }
+
+    template<class TType, class TFunction>
+    TType Treap<TType, TFunction>::prefixValue(index_type t_node, bool t_flipped, std::size_t t_right_index) const {
+        auto &nodes = this->m_pool->nodes;
+        TType result{};
+        bool has_result = false;
+        while (true) {
+            if (t_right_index + 1 == nodes[t_node].size) {
+                auto &segment_value = segmentValue(t_node, t_flipped);
+                return has_result ? this->m_function(result, segment_value) : segment_value;
+            }
+            auto [left, right] = children(t_node, t_flipped);
+            t_flipped = t_flipped != nodes[t_node].reversed;
+            auto left_size = nodeSize(left);
+            if (t_right_index < left_size) {
+                t_node = left;
+                continue;
+            }
+            auto &value = nodes[t_node].value;
+            auto piece = left == null_node ? value : this->m_function(segmentValue(left, t_flipped), value);
+            result = has_result ? this->m_function(result, piece) : piece;
+            has_result = true;
+            if (t_right_index == left_size) {
+                return result;
+            }
+            t_right_index -= left_size + 1;
+            t_node = right;
+        }
+    }
+
+    template<class TType, class TFunction>
+    void Treap<TType, TFunction>::insertAt(std::size_t t_index, const TType &t_value) {
+        index_type left, right;
+        splitNodes(this->m_root, t_index, left, right);
+        auto new_node = createNode(t_value);
+        this->m_root = mergeNodes(mergeNodes(left, new_node), right);
+        this->m_size = nodeSize(this->m_root);
+    }
+
+    template<class TType, class TFunction>
+    void Treap<TType, TFunction>::eraseAt(std::size_t t_index) {
+        index_type left, middle, right;
+        splitNodes(this->m_root, t_index, left, right);
+        splitNodes(right, 1, middle, right);
+        release(middle);
+        this->m_root = mergeNodes(left, right);
+        this->m_size = nodeSize(this->m_root);
+    }
+
+    template<class TType, class TFunction>
+    Treap<TType, TFunction> Treap<TType, TFunction>::split(std::size_t t_count) {
+        index_type right;
+        splitNodes(this->m_root, t_count, this->m_root, right);
+        this->m_size = nodeSize(this->m_root);
+        return Treap<TType, TFunction>(this->m_pool, right, this->m_function);
+    }
+
+    template<class TType, class TFunction>
+    void Treap<TType, TFunction>::merge(Treap<TType, TFunction> &&other) {
+        index_type right = other.m_root;
+        if (other.m_pool != this->m_pool) {
+            std::vector<TType> values;
+            other.collectValues(values);
+            right = build(values.begin(), values.end());
+            other.release(other.m_root);
+        }
+        other.m_root = null_node;
+        other.m_size = 0;
+        this->m_root = mergeNodes(this->m_root, right);
+        this->m_size = nodeSize(this->m_root);
+    }
+
+    template<class TType, class TFunction>
+    void Treap<TType, TFunction>::reverseSegment(std::size_t t_left_index, std::size_t t_right_index) {
+        index_type left, middle, right;
+        splitNodes(this->m_root, t_left_index, left, middle);
+        splitNodes(middle, t_right_index - t_left_index + 1, middle, right);
+        toggleReversed(middle);
+        this->m_root = mergeNodes(mergeNodes(left, middle), right);
+    }
+
+    template<class TType, class TFunction>
+    void Treap<TType, TFunction>::cyclicShift(std::size_t t_left_index, std::size_t t_right_index,
+                                              std::size_t t_shift) {
+        auto length = t_right_index - t_left_index + 1;
+        t_shift %= length;
+        if (t_shift == 0) {
+            return;
         }
-        return result;
+        index_type left, head, tail, right;
+        splitNodes(this->m_root, t_left_index, left, head);
+        splitNodes(head, length, head, right);
+        splitNodes(head, length - t_shift, head, tail);
+        this->m_root = mergeNodes(mergeNodes(left, mergeNodes(tail, head)), right);
     }
 
 }
@@ -0,0 +1,249 @@
+#ifndef COMPETITIVE_ALGORITHMS_WAVELETMATRIX_H
+#define COMPETITIVE_ALGORITHMS_WAVELETMATRIX_H
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+#include "IDataStructure.h"
+#include "Intrinsics.h"
+#include "Parallel.h"
+
+namespace cpa {
+
+    template<class TType>
+    class WaveletMatrix : public IDataStructure<WaveletMatrix<TType>, TType> {
+        static_assert(std::is_integral_v<TType> && !std::is_same_v<TType, bool>,
+                      "WaveletMatrix requires an integral value type");
+    private:
+        using key_type = std::make_unsigned_t<TType>;
+
+        struct level {
+            std::vector<std::uint64_t> words;
+            std::vector<std::uint32_t> ranks;
+            std::size_t zeros;
+        };
+
+        std::vector<TType> m_data;
+        std::vector<level> m_levels;
+        key_type m_min_key{};
+
+        static key_type toKey(TType t_value) noexcept;
+
+        static TType fromKey(key_type t_key) noexcept;
+
+        static std::size_t rankOne(const level &t_level, std::size_t t_index) noexcept;
+
+        [[nodiscard]] bool outOfRange(key_type t_key) const noexcept;
+
+        void build(std::size_t t_thread_count);
+
+    public:
+        WaveletMatrix() = default;
+
+        template<class TIter>
+        WaveletMatrix(TIter t_begin, TIter t_end, std::size_t t_thread_count = 1);
+
+        WaveletMatrix(const WaveletMatrix<TType> &other);
+
+        WaveletMatrix(WaveletMatrix<TType> &&other) noexcept;
+
+        const TType &getValueAt(std::size_t t_index) const;
+
+        TType kthSmallest(std::size_t t_left_index, std::size_t t_right_index, std::size_t t_k) const;
+
+        std::size_t countLess(std::size_t t_left_index, std::size_t t_right_index, TType t_value) const;
+
+        std::size_t rangeFreq(std::size_t t_left_index, std::size_t t_right_index, TType t_lower, TType t_upper) const;
+
+        std::size_t rank(TType t_value, std::size_t t_index) const;
+    };
+
+    template<class TType>
+    template<class TIter>
+    WaveletMatrix<TType>::WaveletMatrix(TIter t_begin, TIter t_end, std::size_t t_thread_count) :
+            m_data(t_begin, t_end) {
+        this->m_size = this->m_data.size();
+        build(resolveThreadCount(t_thread_count));
+    }
+
+    template<class TType>
+    WaveletMatrix<TType>::WaveletMatrix(const WaveletMatrix<TType> &other) {
+        this->m_size = other.m_size;
+        this->m_data = other.m_data;
+        this->m_levels = other.m_levels;
+        this->m_min_key = other.m_min_key;
+    }
+
+    template<class TType>
+    WaveletMatrix<TType>::WaveletMatrix(WaveletMatrix<TType> &&other) noexcept {
+        this->m_size = std::move(other.m_size);
+        this->m_data = std::move(other.m_data);
+        this->m_levels = std::move(other.m_levels);
+        this->m_min_key = std::move(other.m_min_key);
+    }
+
+    template<class TType>
+    typename WaveletMatrix<TType>::key_type WaveletMatrix<TType>::toKey(TType t_value) noexcept {
+        auto key = static_cast<key_type>(t_value);
+        if constexpr (std::is_signed_v<TType>) {
+            key ^= static_cast<key_type>(key_type{1} << (std::numeric_limits<key_type>::digits - 1));
+        }
+        return key;
+    }
+
+    template<class TType>
+    TType WaveletMatrix<TType>::fromKey(key_type t_key) noexcept {
+        if constexpr (std::is_signed_v<TType>) {
+            t_key ^= static_cast<key_type>(key_type{1} << (std::numeric_limits<key_type>::digits - 1));
+        }
+        return static_cast<TType>(t_key);
+    }
+
+    template<class TType>
+    std::size_t WaveletMatrix<TType>::rankOne(const level &t_level, std::size_t t_index) noexcept {
+        auto word = t_level.words[t_index >> 6u] & ((std::uint64_t{1} << (t_index & 63u)) - 1);
+        return t_level.ranks[t_index >> 6u] + popcount(word);
+    }
+
+    template<class TType>
+    bool WaveletMatrix<TType>::outOfRange(key_type t_key) const noexcept {
+        return this->m_levels.size() < std::numeric_limits<key_type>::digits && (t_key >> this->m_levels.size()) != 0;
+    }
+
+    template<class TType>
+    void WaveletMatrix<TType>::build(std::size_t t_thread_count) {
+        auto size = this->m_size;
+        std::vector<key_type> current(size), next(size);
+        this->m_min_key = std::numeric_limits<key_type>::max();
+        for (std::size_t i = 0; i < size; ++i) {
+            this->m_min_key = std::min(this->m_min_key, toKey(this->m_data[i]));
+        }
+        key_type max_key = 0;
+        for (std::size_t i = 0; i < size; ++i) {
+            current[i] = static_cast<key_type>(toKey(this->m_data[i]) - this->m_min_key);
+            max_key = std::max(max_key, current[i]);
+        }
+        auto bits = std::max<std::size_t>(1, bitWidth(max_key));
+        this->m_levels.resize(bits);
+        for (std::size_t depth = 0; depth < bits; ++depth) {
+            auto bit = bits - 1 - depth;
+            auto &current_level = this->m_levels[depth];
+            current_level.words.assign((size >> 6u) + 1, 0);
+            current_level.ranks.assign((size >> 6u) + 1, 0);
+            parallelFor(0, current_level.words.size(), t_thread_count, [&](std::size_t w) {
+                std::uint64_t word = 0;
+                for (auto j = w << 6u; j < std::min((w + 1) << 6u, size); ++j) {
+                    word |= static_cast<std::uint64_t>((current[j] >> bit) & 1u) << (j & 63u);
+                }
+                current_level.words[w] = word;
+            });
+            for (std::size_t w = 1; w < current_level.words.size(); ++w) {
+                current_level.ranks[w] = current_level.ranks[w - 1] + popcount(current_level.words[w - 1]);
+            }
+            current_level.zeros = size - rankOne(current_level, size);
+            parallelFor(0, size, t_thread_count, [&](std::size_t i) {
+                auto ones = rankOne(current_level, i);
+                auto is_one = (current[i] >> bit) & 1u;
+                next[is_one ? current_level.zeros + ones : i - ones] = current[i];
+            });
+            current.swap(next);
+        }
+    }
+
+    template<class TType>
+    const TType &WaveletMatrix<TType>::getValueAt(std::size_t t_index) const {
+        return this->m_data[t_index];
+    }
+
+    template<class TType>
+    TType WaveletMatrix<TType>::kthSmallest(std::size_t t_left_index, std::size_t t_right_index,
+                                            std::size_t t_k) const {
+        auto begin = t_left_index, end = t_right_index + 1;
+        key_type result = 0;
+        for (std::size_t depth = 0; depth < this->m_levels.size(); ++depth) {
+            auto &current_level = this->m_levels[depth];
+            auto ones_begin = rankOne(current_level, begin);
+            auto ones_end = rankOne(current_level, end);
+            auto zeros = (end - begin) - (ones_end - ones_begin);
+            if (t_k < zeros) {
+                begin -= ones_begin;
+                end -= ones_end;
+            } else {
+                t_k -= zeros;
+                result |= static_cast<key_type>(key_type{1} << (this->m_levels.size() - 1 - depth));
+                begin = current_level.zeros + ones_begin;
+                end = current_level.zeros + ones_end;
+            }
+        }
+        return fromKey(static_cast<key_type>(result + this->m_min_key));
+    }
+
+    template<class TType>
+    std::size_t WaveletMatrix<TType>::countLess(std::size_t t_left_index, std::size_t t_right_index,
+                                                TType t_value) const {
+        auto key = toKey(t_value);
+        if (key <= this->m_min_key) {
+            return 0;
+        }
+        key = static_cast<key_type>(key - this->m_min_key);
+        if (outOfRange(key)) {
+            return t_right_index - t_left_index + 1;
+        }
+        auto begin = t_left_index, end = t_right_index + 1;
+        std::size_t result = 0;
+        for (std::size_t depth = 0; depth < this->m_levels.size() && begin < end; ++depth) {
+            auto &current_level = this->m_levels[depth];
+            auto ones_begin = rankOne(current_level, begin);
+            auto ones_end = rankOne(current_level, end);
+            if ((key >> (this->m_levels.size() - 1 - depth)) & 1u) {
+                result += (end - begin) - (ones_end - ones_begin);
+                begin = current_level.zeros + ones_begin;
+                end = current_level.zeros + ones_end;
+            } else {
+                begin -= ones_begin;
+                end -= ones_end;
+            }
+        }
+        return result;
+    }
+
+    template<class TType>
+    std::size_t WaveletMatrix<TType>::rangeFreq(std::size_t t_left_index, std::size_t t_right_index,
+                                                TType t_lower, TType t_upper) const {
+        if (!(t_lower < t_upper)) {
+            return 0;
+        }
+        return countLess(t_left_index, t_right_index, t_upper) - countLess(t_left_index, t_right_index, t_lower);
+    }
+
+    template<class TType>
+    std::size_t WaveletMatrix<TType>::rank(TType t_value, std::size_t t_index) const {
+        auto key = toKey(t_value);
+        if (key < this->m_min_key) {
+            return 0;
+        }
+        key = static_cast<key_type>(key - this->m_min_key);
+        if (outOfRange(key)) {
+            return 0;
+        }
+        std::size_t begin = 0, end = t_index;
+        for (std::size_t depth = 0; depth < this->m_levels.size() && begin < end; ++depth) {
+            auto &current_level = this->m_levels[depth];
+            auto ones_begin = rankOne(current_level, begin);
+            auto ones_end = rankOne(current_level, end);
+            if ((key >> (this->m_levels.size() - 1 - depth)) & 1u) {
+                begin = current_level.zeros + ones_begin;
+                end = current_level.zeros + ones_end;
+            } else {
+                begin -= ones_begin;
+                end -= ones_end;
+            }
+        }
+        return end - begin;
+    }
+
+}
+
+#endif //COMPETITIVE_ALGORITHMS_WAVELETMATRIX_H
@@ -0,0 +1,209 @@
+#ifndef COMPETITIVE_ALGORITHMS_WIDESEGMENTTREE_H
+#define COMPETITIVE_ALGORITHMS_WIDESEGMENTTREE_H
+
+#include "IMutableDataStructure.h"
+#include "ISegmentSolver.h"
+#include "Parallel.h"
+#include "Reduce.h"
+
+namespace cpa {
+
+    template<class TType, class TFunction = std::function<TType(const TType &, const TType &)>,
+            std::size_t t_block_size = 16>
+    class WideSegmentTree :
+            public IMutableDataStructure<WideSegmentTree<TType, TFunction, t_block_size>, TType>,
+            public ISegmentSolver<WideSegmentTree<TType, TFunction, t_block_size>, TType, TFunction> {
+        static_assert(t_block_size >= 2, "WideSegmentTree requires at least two children per node");
+    private:
+        std::vector<TType> m_nodes;
+        std::vector<TType> m_prefix;
+        std::vector<TType> m_suffix;
+        std::vector<std::size_t> m_offsets;
+        std::vector<std::size_t> m_lengths;
+
+        template<class TIter>
+        void build(TIter t_begin, TIter t_end, std::size_t t_thread_count);
+
+        void buildBlock(std::size_t t_level, std::size_t t_block);
+
+        TType reduceRange(std::size_t t_level, std::size_t t_begin, std::size_t t_end) const;
+
+    public:
+        explicit WideSegmentTree(const TFunction &t_function = TFunction());
+
+        template<class TIter>
+        WideSegmentTree(TIter t_begin, TIter t_end, const TFunction &t_function = TFunction(),
+                        std::size_t t_thread_count = 1);
+
+        WideSegmentTree(const WideSegmentTree<TType, TFunction, t_block_size> &other);
+
+        WideSegmentTree(WideSegmentTree<TType, TFunction, t_block_size> &&other) noexcept;
+
+        [[nodiscard]]
+        std::size_t height() const noexcept;
+
+        const TType &getValueAt(std::size_t t_index) const;
+
+        void changeValueAt(std::size_t t_index, const TType &t_value);
+
+        TType valueOnSegment(std::size_t t_left_index, std::size_t t_right_index) const;
+    };
+
+    template<class TType, class TFunction, std::size_t t_block_size>
+    WideSegmentTree<TType, TFunction, t_block_size>::WideSegmentTree(const TFunction &t_function) {
+        this->m_function = t_function;
+    }
+
+    template<class TType, class TFunction, std::size_t t_block_size>
+    template<class TIter>
+    WideSegmentTree<TType, TFunction, t_block_size>::WideSegmentTree(TIter t_begin, TIter t_end,
+                                                                     const TFunction &t_function,
+                                                                     std::size_t t_thread_count) {
+        this->m_function = t_function;
+        build(t_begin, t_end, resolveThreadCount(t_thread_count));
+    }
+
+    template<class TType, class TFunction, std::size_t t_block_size>
+    WideSegmentTree<TType, TFunction, t_block_size>::WideSegmentTree(
+            const WideSegmentTree<TType, TFunction, t_block_size> &other) {
+        this->m_function = other.m_function;
+        this->m_size = other.m_size;
+        this->m_nodes = other.m_nodes;
+        this->m_prefix = other.m_prefix;
+        this->m_suffix = other.m_suffix;
+        this->m_offsets = other.m_offsets;
+        this->m_lengths = other.m_lengths;
+    }
+
+    template<class TType, class TFunction, std::size_t t_block_size>
+    WideSegmentTree<TType, TFunction, t_block_size>::WideSegmentTree(
+            WideSegmentTree<TType, TFunction, t_block_size> &&other) noexcept {
+        this->m_function = std::move(other.m_function);
+        this->m_size = std::move(other.m_size);
+        this->m_nodes = std::move(other.m_nodes);
+        this->m_prefix = std::move(other.m_prefix);
+        this->m_suffix = std::move(other.m_suffix);
+        this->m_offsets = std::move(other.m_offsets);
+        this->m_lengths = std::move(other.m_lengths);
+    }
+
+    template<class TType, class TFunction, std::size_t t_block_size>
+    template<class TIter>
+    void WideSegmentTree<TType, TFunction, t_block_size>::build(TIter t_begin, TIter t_end,
+                                                                std::size_t t_thread_count) {
+        this->m_size = std::distance(t_begin, t_end);
+        if (this->m_size == 0) {
+            return;
+        }
+        std::size_t total = 0;
+        for (auto length = this->m_size;; length = (length + t_block_size - 1) / t_block_size) {
+            this->m_offsets.push_back(total);
+            this->m_lengths.push_back(length);
+            total += (length + t_block_size - 1) / t_block_size * t_block_size;
+            if (length == 1) {
+                break;
+            }
+        }
+        this->m_nodes.resize(total);
+        this->m_prefix.resize(total);
+        this->m_suffix.resize(total);
+        std::copy(t_begin, t_end, this->m_nodes.begin());
+        for (std::size_t level = 0; level < this->m_lengths.size(); ++level) {
+            auto block_count = (this->m_lengths[level] + t_block_size - 1) / t_block_size;
+            parallelFor(0, block_count, t_thread_count, [this, level](std::size_t block) {
+                buildBlock(level, block);
+            });
+        }
+    }
+
+    template<class TType, class TFunction, std::size_t t_block_size>
+    void WideSegmentTree<TType, TFunction, t_block_size>::buildBlock(std::size_t t_level, std::size_t t_block) {
+        auto offset = this->m_offsets[t_level];
+        auto begin = offset + t_block * t_block_size;
+        auto end = offset + std::min((t_block + 1) * t_block_size, this->m_lengths[t_level]);
+        this->m_prefix[begin] = this->m_nodes[begin];
+        for (auto i = begin + 1; i < end; ++i) {
+            this->m_prefix[i] = this->m_function(this->m_prefix[i - 1], this->m_nodes[i]);
+        }
+        this->m_suffix[end - 1] = this->m_nodes[end - 1];
+        for (auto i = end - 1; i > begin; --i) {
+            this->m_suffix[i - 1] = this->m_function(this->m_nodes[i - 1], this->m_suffix[i]);
+        }
+        if (t_level + 1 < this->m_lengths.size()) {
+            this->m_nodes[this->m_offsets[t_level + 1] + t_block] = this->m_prefix[end - 1];
+        }
+    }
+
+    template<class TType, class TFunction, std::size_t t_block_size>
+    TType WideSegmentTree<TType, TFunction, t_block_size>::reduceRange(std::size_t t_level, std::size_t t_begin,
+                                                                       std::size_t t_end) const {
+        auto block_begin = t_begin / t_block_size * t_block_size;
+        auto block_end = std::min(block_begin + t_block_size, this->m_lengths[t_level]);
+        auto offset = this->m_offsets[t_level];
+        if (t_end > block_end) {
+            return this->m_function(this->m_suffix[offset + t_begin], this->m_prefix[offset + t_end - 1]);
+        }
+        if (t_begin == block_begin) {
+            return this->m_prefix[offset + t_end - 1];
+        }
+        if (t_end == block_end) {
+            return this->m_suffix[offset + t_begin];
+        }
+        auto data = this->m_nodes.data() + offset;
+        return reduceSegment(data + t_begin + 1, data + t_end, data[t_begin], this->m_function);
+    }
+
+    template<class TType, class TFunction, std::size_t t_block_size>
+    std::size_t WideSegmentTree<TType, TFunction, t_block_size>::height() const noexcept {
+        return this->m_lengths.size();
+    }
+
+    template<class TType, class TFunction, std::size_t t_block_size>
+    const TType &WideSegmentTree<TType, TFunction, t_block_size>::getValueAt(std::size_t t_index) const {
+        return this->m_nodes[t_index];
+    }
+
+    template<class TType, class TFunction, std::size_t t_block_size>
+    void WideSegmentTree<TType, TFunction, t_block_size>::changeValueAt(std::size_t t_index, const TType &t_value) {
+        this->m_nodes[t_index] = t_value;
+        for (std::size_t level = 0; level < this->m_lengths.size(); ++level) {
+            t_index /= t_block_size;
+            buildBlock(level, t_index);
+        }
+    }
+
+    template<class TType, class TFunction, std::size_t t_block_size>
+    TType WideSegmentTree<TType, TFunction, t_block_size>::valueOnSegment(std::size_t t_left_index,
+                                                                          std::size_t t_right_index) const {
+        TType left_result{}, right_result{};
+        bool has_left = false, has_right = false;
+        auto begin = t_left_index, end = t_right_index + 1;
+        for (std::size_t level = 0;; ++level) {
+            auto offset = this->m_offsets[level];
+            auto first_block = (begin + t_block_size - 1) / t_block_size;
+            auto last_block = end / t_block_size;
+            if (first_block >= last_block) {
+                auto result = reduceRange(level, begin, end);
+                if (has_left) {
+                    result = this->m_function(left_result, result);
+                }
+                return has_right ? this->m_function(result, right_result) : result;
+            }
+            if (begin < first_block * t_block_size) {
+                auto &part = this->m_suffix[offset + begin];
+                left_result = has_left ? this->m_function(left_result, part) : part;
+                has_left = true;
+            }
+            if (last_block * t_block_size < end) {
+                auto &part = this->m_prefix[offset + end - 1];
+                right_result = has_right ? this->m_function(part, right_result) : part;
+                has_right = true;
+            }
+            begin = first_block;
+            end = last_block;
+        }
+    }
+
+}
+
+#endif //COMPETITIVE_ALGORITHMS_WIDESEGMENTTREE_H
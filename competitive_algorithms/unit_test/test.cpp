@@ -12,6 +12,24 @@
 #include "../competitiveProgAlgoLib/FenwickTree.h"
 #include "../competitiveProgAlgoLib/SqrtDecomposer.h"
 #include "../competitiveProgAlgoLib/Treap.h"
+#include "../competitiveProgAlgoLib/LazySegmentTree.h"
+#include "../competitiveProgAlgoLib/DisjointSparseTable.h"
+#include "../competitiveProgAlgoLib/SqrtTree.h"
+#include "../competitiveProgAlgoLib/GroupFenwickTree.h"
+#include "../competitiveProgAlgoLib/RangeFenwickTree.h"
+#include "../competitiveProgAlgoLib/PersistentSegmentTree.h"
+#include "../competitiveProgAlgoLib/WaveletMatrix.h"
+#include "../competitiveProgAlgoLib/WideSegmentTree.h"
+#include "../competitiveProgAlgoLib/FenwickTree2D.h"
+#include "../competitiveProgAlgoLib/SparseTable2D.h"
+#include "../competitiveProgAlgoLib/SegmentTree2D.h"
+#include "../competitiveProgAlgoLib/CompressedFenwickTree2D.h"
+#include "../competitiveProgAlgoLib/Mo.h"
+#include "../competitiveProgAlgoLib/ConcurrentSegmentTree.h"
+#include "../competitiveProgAlgoLib/AnySegmentSolver.h"
+#include "../competitiveProgAlgoLib/AdaptiveSegmentSolver.h"
+#include "../competitiveProgAlgoLib/Stats.h"
+#include "../competitiveProgAlgoLib/Snapshot.h"
 
 
 TEST_CASE("Directed graph testing", "[graph]") {
@@ -486,24 +504,1217 @@ TEST_CASE("Range query", "[data_structure]") {
         for (auto &val : data) {
             val = GENERATE(take(1, random(-1000, 1000)));
         }
-        std::vector<cpa::ISegmentSolver<int> *> testing_struct{
-                new cpa::Array<int>(data.begin(), data.end(), minimum),
-                new cpa::SparseTable<int>(data.begin(), data.end(), minimum),
-                new cpa::SegmentTree<int>(data.begin(), data.end(), minimum),
-                new cpa::FenwickTree<int>(data.begin(), data.end(), minimum),
-                new cpa::SqrtDecomposer<int>(data.begin(), data.end(), minimum),
-                new cpa::Treap<int>(data.begin(), data.end(), minimum),
+        std::vector<cpa::AnySegmentSolver<int>> testing_struct{
+                cpa::Array<int>(data.begin(), data.end(), minimum),
+                cpa::SparseTable<int>(data.begin(), data.end(), minimum),
+                cpa::SegmentTree<int>(data.begin(), data.end(), minimum),
+                cpa::FenwickTree<int>(data.begin(), data.end(), minimum),
+                cpa::SqrtDecomposer<int>(data.begin(), data.end(), minimum),
+                cpa::Treap<int>(data.begin(), data.end(), minimum),
+                cpa::LazySegmentTree<int>(data.begin(), data.end(), minimum),
+                cpa::DisjointSparseTable<int>(data.begin(), data.end(), minimum),
+                cpa::SqrtTree<int>(data.begin(), data.end(), minimum),
+                cpa::WideSegmentTree<int>(data.begin(), data.end(), minimum),
         };
         for (auto &ds : testing_struct) {
             for (std::size_t l = 0; l < data.size(); ++l) {
                 auto mn = data[l];
                 for (std::size_t r = l; r < data.size(); ++r) {
                     mn = minimum(mn, data[r]);
-                    REQUIRE(ds->valueOnSegment(l, r) == mn);
+                    REQUIRE(ds.valueOnSegment(l, r) == mn);
                 }
             }
-            delete ds;
         }
     }
 
-}
\ No newline at end of file
+}
+
+TEST_CASE("Range query with monoid policies", "[data_structure]") {
+
+    static_assert(cpa::MonoidTraits<cpa::Min<int>>::idempotent);
+    static_assert(cpa::MonoidTraits<cpa::Sum<int>>::invertible);
+    static_assert(!cpa::is_monoid_v<std::function<int(const int &, const int &)>>);
+
+    std::vector<int> data(GENERATE(take(50, random(1, 100))));
+    for (auto &val : data) {
+        val = GENERATE(take(1, random(-1000, 1000)));
+    }
+
+    SECTION("minimum") {
+        std::vector<cpa::AnySegmentSolver<int>> testing_struct{
+                cpa::Array<int, cpa::Min<int>>(data.begin(), data.end()),
+                cpa::SparseTable<int, cpa::Min<int>>(data.begin(), data.end()),
+                cpa::SegmentTree<int, cpa::Min<int>>(data.begin(), data.end()),
+                cpa::FenwickTree<int, cpa::Min<int>>(data.begin(), data.end()),
+                cpa::SqrtDecomposer<int, cpa::Min<int>>(data.begin(), data.end()),
+                cpa::Treap<int, cpa::Min<int>>(data.begin(), data.end()),
+                cpa::WideSegmentTree<int, cpa::Min<int>>(data.begin(), data.end()),
+        };
+        for (auto &ds : testing_struct) {
+            for (std::size_t l = 0; l < data.size(); ++l) {
+                auto mn = cpa::Min<int>::identity();
+                for (std::size_t r = l; r < data.size(); ++r) {
+                    mn = std::min(mn, data[r]);
+                    REQUIRE(ds.valueOnSegment(l, r) == mn);
+                }
+            }
+        }
+    }
+
+    SECTION("sum") {
+        std::vector<cpa::AnySegmentSolver<int>> testing_struct{
+                cpa::Array<int, cpa::Sum<int>>(data.begin(), data.end()),
+                cpa::SegmentTree<int, cpa::Sum<int>>(data.begin(), data.end()),
+                cpa::FenwickTree<int, cpa::Sum<int>>(data.begin(), data.end()),
+                cpa::SqrtDecomposer<int, cpa::Sum<int>>(data.begin(), data.end()),
+                cpa::Treap<int, cpa::Sum<int>>(data.begin(), data.end()),
+                cpa::DisjointSparseTable<int, cpa::Sum<int>>(data.begin(), data.end()),
+                cpa::SqrtTree<int, cpa::Sum<int>>(data.begin(), data.end()),
+                cpa::GroupFenwickTree<int>(data.begin(), data.end()),
+                cpa::RangeFenwickTree<int>(data.begin(), data.end()),
+                cpa::WideSegmentTree<int, cpa::Sum<int>, 4>(data.begin(), data.end()),
+        };
+        for (auto &ds : testing_struct) {
+            for (std::size_t l = 0; l < data.size(); ++l) {
+                auto sum = cpa::Sum<int>::identity();
+                for (std::size_t r = l; r < data.size(); ++r) {
+                    sum += data[r];
+                    REQUIRE(ds.valueOnSegment(l, r) == sum);
+                }
+            }
+        }
+    }
+
+}
+
+TEST_CASE("Static solver interface", "[data_structure]") {
+
+    static_assert(!std::is_polymorphic_v<cpa::SegmentTree<int, cpa::Sum<int>>>);
+    static_assert(!std::is_polymorphic_v<cpa::SparseTable<int, cpa::Min<int>>>);
+
+    std::vector<int> data(GENERATE(take(10, random(1, 100))));
+    for (auto &val : data) {
+        val = GENERATE(take(1, random(-1000, 1000)));
+    }
+    auto total = [](const auto &t_solver, std::size_t t_size) {
+        return t_solver.valueOnSegment(0, t_size - 1);
+    };
+    cpa::SegmentTree<int, cpa::Sum<int>> segment_tree(data.begin(), data.end());
+    cpa::FenwickTree<int, cpa::Sum<int>> fenwick_tree(data.begin(), data.end());
+    const cpa::ISegmentSolver<cpa::SegmentTree<int, cpa::Sum<int>>, int, cpa::Sum<int>> &segment_base = segment_tree;
+    const cpa::ISegmentSolver<cpa::FenwickTree<int, cpa::Sum<int>>, int, cpa::Sum<int>> &fenwick_base = fenwick_tree;
+    auto expected = std::accumulate(data.begin(), data.end(), 0);
+    REQUIRE(total(segment_base, data.size()) == expected);
+    REQUIRE(total(fenwick_base, data.size()) == expected);
+
+    cpa::AnySegmentSolver<int> any(segment_tree);
+    auto copy = any;
+    any = cpa::AnySegmentSolver<int>(fenwick_tree);
+    REQUIRE(copy.size() == data.size());
+    REQUIRE(total(copy, data.size()) == expected);
+    REQUIRE(total(any, data.size()) == expected);
+
+}
+
+TEST_CASE("Batched range query", "[data_structure]") {
+
+    std::vector<int> data(GENERATE(take(20, random(1, 300))));
+    for (auto &val : data) {
+        val = GENERATE(take(1, random(-1000, 1000)));
+    }
+    std::vector<std::pair<std::size_t, std::size_t>> queries;
+    std::vector<int> expected;
+    for (std::size_t l = 0; l < data.size(); l += 3) {
+        auto mn = data[l];
+        for (std::size_t r = l; r < data.size(); ++r) {
+            mn = std::min(mn, data[r]);
+            queries.emplace_back(l, r);
+            expected.push_back(mn);
+        }
+    }
+
+    std::vector<cpa::AnySegmentSolver<int>> testing_struct{
+            cpa::Array<int, cpa::Min<int>>(data.begin(), data.end()),
+            cpa::SparseTable<int, cpa::Min<int>>(data.begin(), data.end()),
+            cpa::SegmentTree<int, cpa::Min<int>>(data.begin(), data.end()),
+            cpa::FenwickTree<int, cpa::Min<int>>(data.begin(), data.end()),
+            cpa::SqrtDecomposer<int, cpa::Min<int>>(data.begin(), data.end()),
+            cpa::Treap<int, cpa::Min<int>>(data.begin(), data.end()),
+    };
+    for (auto &ds : testing_struct) {
+        std::vector<int> result;
+        ds.valueOnSegments(queries, result);
+        REQUIRE_THAT(result, Catch::Equals(expected));
+    }
+
+    cpa::SparseTable<int, cpa::Min<int>> sparse_table(data.begin(), data.end());
+    cpa::Array<int, cpa::Min<int>> array(data.begin(), data.end());
+    const cpa::ISegmentSolver<cpa::SparseTable<int, cpa::Min<int>>, int, cpa::Min<int>> &sparse_base = sparse_table;
+    const cpa::ISegmentSolver<cpa::Array<int, cpa::Min<int>>, int, cpa::Min<int>> &array_base = array;
+    std::vector<int> result;
+    sparse_base.valueOnSegments(queries, result);
+    REQUIRE_THAT(result, Catch::Equals(expected));
+    array_base.valueOnSegments(queries, result);
+    REQUIRE_THAT(result, Catch::Equals(expected));
+
+}
+
+TEST_CASE("Range update", "[data_structure]") {
+
+    std::vector<long long> data(GENERATE(take(20, random(1, 100))));
+    for (auto &val : data) {
+        val = GENERATE(take(1, random(-1000, 1000)));
+    }
+    auto operations = GENERATE(take(1, chunk(600, random(0, 1000000))));
+
+    SECTION("minimum with range add") {
+        cpa::LazySegmentTree<long long, cpa::Min<long long>, cpa::AddAction<long long>> ds(data.begin(), data.end());
+        for (std::size_t i = 0; i + 2 < operations.size(); i += 3) {
+            auto l = operations[i] % data.size();
+            auto r = operations[i + 1] % data.size();
+            if (l > r) {
+                std::swap(l, r);
+            }
+            auto delta = operations[i + 2] % 201 - 100;
+            ds.applyOnSegment(l, r, delta);
+            for (auto j = l; j <= r; ++j) {
+                data[j] += delta;
+            }
+            REQUIRE(ds.valueOnSegment(l, r) == *std::min_element(data.begin() + l, data.begin() + r + 1));
+            REQUIRE(ds.getValueAt(l) == data[l]);
+        }
+        REQUIRE(ds.valueOnSegment(0, data.size() - 1) == *std::min_element(data.begin(), data.end()));
+    }
+
+    SECTION("sum with range assign") {
+        cpa::LazySegmentTree<long long, cpa::Sum<long long>, cpa::AssignAction<long long, true>> ds(data.begin(),
+                                                                                                    data.end());
+        for (std::size_t i = 0; i + 2 < operations.size(); i += 3) {
+            auto l = operations[i] % data.size();
+            auto r = operations[i + 1] % data.size();
+            if (l > r) {
+                std::swap(l, r);
+            }
+            auto value = operations[i + 2] % 201 - 100;
+            ds.applyOnSegment(l, r, value);
+            std::fill(data.begin() + l, data.begin() + r + 1, value);
+            ds.changeValueAt(r, value + 1);
+            data[r] = value + 1;
+            REQUIRE(ds.valueOnSegment(0, r) == std::accumulate(data.begin(), data.begin() + r + 1, 0LL));
+        }
+    }
+
+    SECTION("sum with affine action") {
+        cpa::LazySegmentTree<long long, cpa::Sum<long long>, cpa::AffineAction<long long, true>> ds(data.begin(),
+                                                                                                    data.end());
+        for (std::size_t i = 0; i + 2 < operations.size(); i += 3) {
+            auto l = operations[i] % data.size();
+            auto r = operations[i + 1] % data.size();
+            if (l > r) {
+                std::swap(l, r);
+            }
+            long long a = operations[i + 2] % 3 - 1;
+            long long b = operations[i + 2] % 11 - 5;
+            ds.applyOnSegment(l, r, {a, b});
+            for (auto j = l; j <= r; ++j) {
+                data[j] = a * data[j] + b;
+            }
+            REQUIRE(ds.valueOnSegment(l, data.size() - 1) ==
+                    std::accumulate(data.begin() + l, data.end(), 0LL));
+            REQUIRE(ds.getValueAt(r) == data[r]);
+        }
+    }
+
+    SECTION("concurrent const readers") {
+        cpa::LazySegmentTree<long long, cpa::Min<long long>, cpa::AddAction<long long>> ds(data.begin(), data.end());
+        for (std::size_t i = 0; i + 2 < operations.size(); i += 3) {
+            auto l = std::min(operations[i], operations[i + 1]) % data.size();
+            auto r = std::max<std::size_t>(l, operations[i + 1] % data.size());
+            ds.applyOnSegment(l, r, operations[i + 2] % 201 - 100);
+            for (auto j = l; j <= r; ++j) {
+                data[j] += operations[i + 2] % 201 - 100;
+            }
+        }
+        const auto &view = ds;
+        std::vector<std::size_t> mismatches(4);
+        std::vector<std::thread> readers;
+        for (std::size_t t = 0; t < mismatches.size(); ++t) {
+            readers.emplace_back([&, t] {
+                for (std::size_t l = 0; l < data.size(); ++l) {
+                    for (auto r = l; r < data.size(); ++r) {
+                        mismatches[t] += view.valueOnSegment(l, r) !=
+                                         *std::min_element(data.begin() + l, data.begin() + r + 1);
+                    }
+                    mismatches[t] += view.getValueAt(l) != data[l];
+                }
+            });
+        }
+        for (auto &reader : readers) {
+            reader.join();
+        }
+        REQUIRE(std::accumulate(mismatches.begin(), mismatches.end(), std::size_t{0}) == 0);
+    }
+
+}
+
+TEST_CASE("Range query with non-commutative function", "[data_structure]") {
+
+    std::size_t length = GENERATE(take(10, random(1, 80)));
+    auto concatenation = [](const std::string &a, const std::string &b) {
+        return a + b;
+    };
+    std::vector<std::string> letters;
+    for (std::size_t i = 0; i < length; ++i) {
+        letters.emplace_back(1, static_cast<char>('a' + (i * 7 + length) % 26));
+    }
+    cpa::DisjointSparseTable<std::string> ds(letters.begin(), letters.end(), concatenation);
+    cpa::SqrtTree<std::string> sqrt_tree(letters.begin(), letters.end(), concatenation);
+    cpa::Treap<std::string> treap(letters.begin(), letters.end(), concatenation);
+    cpa::WideSegmentTree<std::string, std::function<std::string(const std::string &, const std::string &)>, 3>
+            wide_tree(letters.begin(), letters.end(), concatenation);
+    for (std::size_t l = 0; l < letters.size(); ++l) {
+        std::string expected;
+        for (std::size_t r = l; r < letters.size(); ++r) {
+            expected += letters[r];
+            REQUIRE(ds.valueOnSegment(l, r) == expected);
+            REQUIRE(sqrt_tree.valueOnSegment(l, r) == expected);
+            REQUIRE(treap.valueOnSegment(l, r) == expected);
+            REQUIRE(wide_tree.valueOnSegment(l, r) == expected);
+        }
+    }
+
+}
+
+TEST_CASE("Vectorized linear scan", "[data_structure]") {
+
+    std::vector<std::int16_t> data(GENERATE(take(10, random(1, 2000))));
+    for (auto &val : data) {
+        val = static_cast<std::int16_t>(GENERATE(take(1, random(-30000, 30000))));
+    }
+    cpa::Array<std::int16_t, cpa::Max<std::int16_t>> array(data.begin(), data.end());
+    cpa::SqrtDecomposer<std::int16_t, cpa::Xor<std::int16_t>> sqrt_decomposer(data.begin(), data.end());
+    for (std::size_t l = 0; l < data.size(); l += 7) {
+        auto mx = data[l];
+        std::int16_t xr = 0;
+        for (std::size_t r = l; r < data.size(); ++r) {
+            mx = std::max(mx, data[r]);
+            xr ^= data[r];
+            REQUIRE(array.valueOnSegment(l, r) == mx);
+            REQUIRE(sqrt_decomposer.valueOnSegment(l, r) == xr);
+        }
+    }
+
+    sqrt_decomposer.changeValueAt(data.size() - 1, 0);
+    data.back() = 0;
+    REQUIRE(sqrt_decomposer.valueOnSegment(0, data.size() - 1) ==
+            std::accumulate(data.begin(), data.end(), std::int16_t(0), cpa::Xor<std::int16_t>()));
+
+}
+
+TEST_CASE("Parallel construction", "[data_structure]") {
+
+    std::vector<long long> data(100000 + GENERATE(take(3, random(0, 1000))));
+    std::mt19937 rnd(static_cast<unsigned>(data.size()));
+    for (auto &val : data) {
+        val = static_cast<long long>(rnd() % 2000001) - 1000000;
+    }
+    cpa::SparseTable<long long, cpa::Min<long long>> sparse_table(data.begin(), data.end(), {}, 4);
+    cpa::SegmentTree<long long, cpa::Sum<long long>> segment_tree(data.begin(), data.end(), {}, 4);
+    cpa::FenwickTree<long long, cpa::Max<long long>> fenwick_tree(data.begin(), data.end(), {}, 0);
+    cpa::WaveletMatrix<long long> wavelet_matrix(data.begin(), data.end(), 4);
+    for (int q = 0; q < 1000; ++q) {
+        auto l = rnd() % data.size();
+        auto r = rnd() % data.size();
+        if (l > r) {
+            std::swap(l, r);
+        }
+        auto begin = data.begin() + l;
+        auto end = data.begin() + r + 1;
+        REQUIRE(sparse_table.valueOnSegment(l, r) == *std::min_element(begin, end));
+        REQUIRE(segment_tree.valueOnSegment(l, r) == std::accumulate(begin, end, 0LL));
+        REQUIRE(fenwick_tree.valueOnSegment(l, r) == *std::max_element(begin, end));
+        REQUIRE(wavelet_matrix.kthSmallest(l, r, 0) == *std::min_element(begin, end));
+        REQUIRE(wavelet_matrix.countLess(l, r, data[l]) ==
+                static_cast<std::size_t>(std::count_if(begin, end, [&](long long x) { return x < data[l]; })));
+    }
+
+    for (auto failing : {std::size_t{0}, data.size() - 1}) {
+        std::atomic<std::size_t> visited{0};
+        REQUIRE_THROWS_AS(cpa::parallelFor(0, data.size(), 4, [&](std::size_t i) {
+            if (i == failing) {
+                throw std::runtime_error("parallelFor failure");
+            }
+            ++visited;
+        }), std::runtime_error);
+        REQUIRE(visited < data.size());
+    }
+
+}
+
+TEST_CASE("Sqrt tree point update", "[data_structure]") {
+
+    std::vector<long long> data(GENERATE(take(10, random(1, 700))));
+    for (auto &val : data) {
+        val = GENERATE(take(1, random(-1000, 1000)));
+    }
+    auto operations = GENERATE(take(1, chunk(300, random(0, 1000000))));
+    cpa::SqrtTree<long long, cpa::Sum<long long>> ds(data.begin(), data.end());
+    for (std::size_t i = 0; i + 2 < operations.size(); i += 3) {
+        auto index = operations[i] % data.size();
+        data[index] = operations[i + 1] % 2001 - 1000;
+        ds.changeValueAt(index, data[index]);
+        REQUIRE(ds.getValueAt(index) == data[index]);
+        auto l = operations[i + 2] % data.size();
+        for (auto r = l; r < data.size(); r += 1 + r / 8) {
+            REQUIRE(ds.valueOnSegment(l, r) == std::accumulate(data.begin() + l, data.begin() + r + 1, 0LL));
+        }
+    }
+
+}
+
+TEST_CASE("Fenwick tree over a group", "[data_structure]") {
+
+    std::vector<long long> data(GENERATE(take(20, random(1, 200))));
+    for (auto &val : data) {
+        val = GENERATE(take(1, random(0, 1000)));
+    }
+    auto operations = GENERATE(take(1, chunk(300, random(0, 1000000))));
+
+    SECTION("point assignment and lower bound") {
+        cpa::GroupFenwickTree<long long> ds(data.begin(), data.end());
+        cpa::GroupFenwickTree<long long, cpa::Xor<long long>> xor_ds(data.begin(), data.end());
+        for (std::size_t i = 0; i + 2 < operations.size(); i += 3) {
+            auto index = operations[i] % data.size();
+            data[index] = operations[i + 1] % 1001;
+            ds.changeValueAt(index, data[index]);
+            xor_ds.changeValueAt(index, data[index]);
+            REQUIRE(ds.getValueAt(index) == data[index]);
+
+            auto l = operations[i + 2] % data.size();
+            REQUIRE(ds.prefix(l) == std::accumulate(data.begin(), data.begin() + l + 1, 0LL));
+            REQUIRE(ds.valueOnSegment(l, data.size() - 1) == std::accumulate(data.begin() + l, data.end(), 0LL));
+            REQUIRE(xor_ds.valueOnSegment(l, data.size() - 1) ==
+                    std::accumulate(data.begin() + l, data.end(), 0LL, cpa::Xor<long long>()));
+            REQUIRE(xor_ds.getValueAt(l) == data[l]);
+            ds.addValueAt(l, 7);
+            data[l] += 7;
+            xor_ds.changeValueAt(l, data[l]);
+            REQUIRE(ds.getValueAt(l) == data[l]);
+
+            long long target = operations[i + 2] % (std::accumulate(data.begin(), data.end(), 0LL) + 2);
+            std::size_t expected = 0;
+            for (long long sum = 0; expected < data.size() && sum + data[expected] < target; ++expected) {
+                sum += data[expected];
+            }
+            REQUIRE(ds.lowerBound(target) == expected);
+        }
+    }
+
+    SECTION("range add") {
+        cpa::RangeFenwickTree<long long> ds(data.begin(), data.end());
+        for (std::size_t i = 0; i + 2 < operations.size(); i += 3) {
+            auto l = operations[i] % data.size();
+            auto r = operations[i + 1] % data.size();
+            if (l > r) {
+                std::swap(l, r);
+            }
+            auto delta = operations[i + 2] % 201 - 100;
+            ds.addOnSegment(l, r, delta);
+            for (auto j = l; j <= r; ++j) {
+                data[j] += delta;
+            }
+            REQUIRE(ds.getValueAt(r) == data[r]);
+            REQUIRE(ds.valueOnSegment(l, data.size() - 1) == std::accumulate(data.begin() + l, data.end(), 0LL));
+            REQUIRE(ds.prefix(r) == std::accumulate(data.begin(), data.begin() + r + 1, 0LL));
+        }
+    }
+
+}
+
+TEST_CASE("Sqrt decomposition with range update", "[data_structure]") {
+
+    std::vector<long long> data(GENERATE(take(20, random(1, 300))));
+    for (auto &val : data) {
+        val = GENERATE(take(1, random(-1000, 1000)));
+    }
+    std::size_t block_size = GENERATE(0, 1, 5, 64);
+    auto operations = GENERATE(take(1, chunk(600, random(0, 1000000))));
+
+    SECTION("sum with range add") {
+        cpa::SqrtDecomposer<long long, cpa::Sum<long long>, cpa::AddAction<long long, true>> ds(
+                data.begin(), data.end(), {}, block_size);
+        REQUIRE(ds.blockSize() > 0);
+        for (std::size_t i = 0; i + 2 < operations.size(); i += 3) {
+            auto l = operations[i] % data.size();
+            auto r = operations[i + 1] % data.size();
+            if (l > r) {
+                std::swap(l, r);
+            }
+            auto delta = operations[i + 2] % 201 - 100;
+            ds.applyOnSegment(l, r, delta);
+            for (auto j = l; j <= r; ++j) {
+                data[j] += delta;
+            }
+            ds.changeValueAt(l, delta);
+            data[l] = delta;
+            REQUIRE(ds.getValueAt(r) == data[r]);
+            REQUIRE(ds.valueOnSegment(0, r) == std::accumulate(data.begin(), data.begin() + r + 1, 0LL));
+            REQUIRE(ds.valueOnSegment(l, data.size() - 1) == std::accumulate(data.begin() + l, data.end(), 0LL));
+        }
+    }
+
+    SECTION("minimum with range assign") {
+        cpa::SqrtDecomposer<long long, cpa::Min<long long>, cpa::AssignAction<long long>> ds(
+                data.begin(), data.end(), {}, block_size);
+        for (std::size_t i = 0; i + 2 < operations.size(); i += 3) {
+            auto l = operations[i] % data.size();
+            auto r = operations[i + 1] % data.size();
+            if (l > r) {
+                std::swap(l, r);
+            }
+            auto value = operations[i + 2] % 2001 - 1000;
+            ds.applyOnSegment(l, r, value);
+            std::fill(data.begin() + l, data.begin() + r + 1, value);
+            REQUIRE(ds.valueOnSegment(0, r) == *std::min_element(data.begin(), data.begin() + r + 1));
+            REQUIRE(ds.valueOnSegment(l, data.size() - 1) == *std::min_element(data.begin() + l, data.end()));
+        }
+    }
+
+    SECTION("concurrent const readers") {
+        cpa::SqrtDecomposer<long long, cpa::Sum<long long>, cpa::AddAction<long long, true>> ds(
+                data.begin(), data.end(), {}, block_size);
+        for (std::size_t i = 0; i + 2 < operations.size(); i += 3) {
+            auto l = std::min(operations[i], operations[i + 1]) % data.size();
+            auto r = std::max<std::size_t>(l, operations[i + 1] % data.size());
+            ds.applyOnSegment(l, r, operations[i + 2] % 201 - 100);
+            for (auto j = l; j <= r; ++j) {
+                data[j] += operations[i + 2] % 201 - 100;
+            }
+        }
+        const auto &view = ds;
+        std::vector<std::size_t> mismatches(4);
+        std::vector<std::thread> readers;
+        for (std::size_t t = 0; t < mismatches.size(); ++t) {
+            readers.emplace_back([&, t] {
+                for (std::size_t l = 0; l < data.size(); ++l) {
+                    auto expected = 0LL;
+                    for (auto r = l; r < data.size(); ++r) {
+                        expected += data[r];
+                        mismatches[t] += view.valueOnSegment(l, r) != expected;
+                    }
+                    mismatches[t] += view.getValueAt(l) != data[l];
+                }
+            });
+        }
+        for (auto &reader : readers) {
+            reader.join();
+        }
+        REQUIRE(std::accumulate(mismatches.begin(), mismatches.end(), std::size_t{0}) == 0);
+    }
+
+}
+
+TEST_CASE("Treap copy and point update", "[data_structure]") {
+
+    std::vector<long long> data(GENERATE(take(10, random(1, 100000))));
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<long long>(i * 2654435761u % 1000);
+    }
+    auto operations = GENERATE(take(1, chunk(300, random(0, 1000000))));
+    cpa::Treap<long long, cpa::Sum<long long>> treap(data.begin(), data.end());
+    cpa::Treap<long long, cpa::Sum<long long>> copy(treap);
+    auto original = data;
+    for (std::size_t i = 0; i + 2 < operations.size(); i += 3) {
+        auto l = operations[i] % data.size();
+        auto r = operations[i + 1] % data.size();
+        if (l > r) {
+            std::swap(l, r);
+        }
+        treap.changeValueAt(l, operations[i + 2]);
+        data[l] = operations[i + 2];
+        REQUIRE(treap.getValueAt(l) == data[l]);
+        REQUIRE(treap.valueOnSegment(l, r) == std::accumulate(data.begin() + l, data.begin() + r + 1, 0LL));
+        REQUIRE(copy.valueOnSegment(l, r) == std::accumulate(original.begin() + l, original.begin() + r + 1, 0LL));
+    }
+    cpa::Treap<long long, cpa::Sum<long long>> moved(std::move(copy));
+    REQUIRE(moved.size() == data.size());
+    REQUIRE(moved.valueOnSegment(0, data.size() - 1) == std::accumulate(original.begin(), original.end(), 0LL));
+
+}
+
+TEST_CASE("Treap sequence operations", "[data_structure]") {
+
+    auto operations = GENERATE(take(20, chunk(1500, random(0, 1000000))));
+    auto concatenation = [](const std::string &a, const std::string &b) {
+        return a + b;
+    };
+    std::vector<std::string> data;
+    cpa::Treap<std::string> treap(concatenation);
+    std::vector<std::pair<cpa::Treap<std::string>, std::vector<std::string>>> snapshots;
+    for (std::size_t i = 0; i + 4 < operations.size(); i += 5) {
+        auto type = operations[i] % 8;
+        if (data.empty() || type == 0) {
+            auto position = operations[i + 1] % (data.size() + 1);
+            std::string value(1, static_cast<char>('a' + operations[i + 2] % 26));
+            treap.insertAt(position, value);
+            data.insert(data.begin() + position, value);
+            continue;
+        }
+        auto l = operations[i + 1] % data.size();
+        auto r = operations[i + 2] % data.size();
+        if (l > r) {
+            std::swap(l, r);
+        }
+        if (type == 1) {
+            treap.eraseAt(l);
+            data.erase(data.begin() + l);
+        } else if (type == 2) {
+            treap.reverseSegment(l, r);
+            std::reverse(data.begin() + l, data.begin() + r + 1);
+        } else if (type == 3) {
+            auto shift = operations[i + 3];
+            treap.cyclicShift(l, r, shift);
+            std::rotate(data.begin() + l, data.begin() + r + 1 - shift % (r - l + 1), data.begin() + r + 1);
+        } else if (type == 4) {
+            auto tail = treap.split(l);
+            REQUIRE(treap.size() == l);
+            REQUIRE(tail.size() == data.size() - l);
+            if (operations[i + 3] % 2 == 0) {
+                tail.merge(std::move(treap));
+                treap.merge(std::move(tail));
+                std::rotate(data.begin(), data.begin() + l, data.end());
+            } else {
+                cpa::Treap<std::string> copy(tail);
+                treap.merge(std::move(copy));
+            }
+        } else if (type == 5) {
+            std::string value(1, static_cast<char>('A' + operations[i + 3] % 26));
+            treap.changeValueAt(l, value);
+            data[l] = value;
+        } else if (type == 6) {
+            snapshots.emplace_back(treap, data);
+        }
+        REQUIRE(treap.size() == data.size());
+        if (data.empty()) {
+            continue;
+        }
+        l = operations[i + 3] % data.size();
+        r = operations[i + 4] % data.size();
+        if (l > r) {
+            std::swap(l, r);
+        }
+        std::string expected;
+        for (auto j = l; j <= r; ++j) {
+            expected += data[j];
+        }
+        REQUIRE(treap.valueOnSegment(l, r) == expected);
+        REQUIRE(treap.getValueAt(r) == data[r]);
+    }
+    for (auto &[snapshot, values] : snapshots) {
+        REQUIRE(snapshot.size() == values.size());
+        std::string expected;
+        for (std::size_t j = 0; j < values.size(); ++j) {
+            expected += values[j];
+            REQUIRE(snapshot.getValueAt(j) == values[j]);
+            REQUIRE(snapshot.valueOnSegment(0, j) == expected);
+        }
+    }
+
+}
+
+TEST_CASE("Persistent segment tree", "[data_structure]") {
+
+    std::vector<long long> data(GENERATE(take(10, random(1, 200))));
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<long long>(i * 2654435761u % 1000);
+    }
+    auto operations = GENERATE(take(1, chunk(900, random(0, 1000000))));
+    cpa::PersistentSegmentTree<long long, cpa::Sum<long long>> tree(data.begin(), data.end());
+    std::vector<std::vector<long long>> versions{data};
+    std::vector<bool> erased{false};
+    auto check = [&](std::size_t version, std::size_t l, std::size_t r) {
+        auto &values = versions[version];
+        REQUIRE(tree.getValueAt(version, r) == values[r]);
+        REQUIRE(tree.valueOnSegment(version, l, r) ==
+                std::accumulate(values.begin() + l, values.begin() + r + 1, 0LL));
+    };
+    for (std::size_t i = 0; i + 2 < operations.size(); i += 3) {
+        auto base = operations[i] % versions.size();
+        while (erased[base]) {
+            base = (base + 1) % versions.size();
+        }
+        auto l = operations[i + 1] % data.size();
+        auto r = operations[i + 2] % data.size();
+        if (l > r) {
+            std::swap(l, r);
+        }
+        auto values = versions[base];
+        values[l] = operations[i + 2];
+        REQUIRE(tree.changeValueAt(base, l, values[l]) == versions.size());
+        versions.push_back(values);
+        erased.push_back(false);
+        check(base, l, r);
+        check(versions.size() - 1, l, r);
+        if (operations[i] % 5 == 0 && base != versions.size() - 1) {
+            tree.eraseVersion(base);
+            erased[base] = true;
+        }
+        if (operations[i] % 37 == 0) {
+            auto before = tree.nodeCount();
+            tree.collectGarbage();
+            REQUIRE(tree.nodeCount() <= before);
+        }
+    }
+    tree.collectGarbage();
+    REQUIRE(tree.versionCount() == versions.size());
+    for (std::size_t version = 0; version < versions.size(); ++version) {
+        if (!erased[version]) {
+            check(version, 0, data.size() - 1);
+        }
+    }
+    tree.changeValueAt(0, 7);
+    REQUIRE(tree.getValueAt(0) == 7);
+    REQUIRE(tree.valueOnSegment(0, 0) == 7);
+    auto newest = tree.latestVersion();
+    tree.eraseVersion(newest);
+    REQUIRE(tree.latestVersion() < newest);
+    REQUIRE(tree.valueOnSegment(0, data.size() - 1) ==
+            tree.valueOnSegment(tree.latestVersion(), 0, data.size() - 1));
+    REQUIRE_THROWS_AS(tree.valueOnSegment(newest, 0, 0), std::out_of_range);
+    REQUIRE_THROWS_AS(tree.getValueAt(newest, 0), std::out_of_range);
+    REQUIRE_THROWS_AS(tree.changeValueAt(newest, 0, 1), std::out_of_range);
+    REQUIRE_THROWS_AS(tree.valueOnSegment(tree.versionCount(), 0, 0), std::out_of_range);
+    cpa::PersistentSegmentTree<long long, cpa::Sum<long long>> empty;
+    REQUIRE_THROWS_AS(empty.latestVersion(), std::out_of_range);
+
+}
+
+TEST_CASE("Persistent segment tree with concurrent readers", "[data_structure]") {
+
+    std::vector<long long> data(GENERATE(take(5, random(1, 200))));
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<long long>(i * 2654435761u % 1000);
+    }
+    cpa::PersistentSegmentTree<long long, cpa::Sum<long long>> tree(data.begin(), data.end());
+    std::vector<long long> totals{std::accumulate(data.begin(), data.end(), 0LL)};
+    for (std::size_t i = 0; i < 64; ++i) {
+        tree.changeValueAt(i % data.size(), static_cast<long long>(i));
+        data[i % data.size()] = static_cast<long long>(i);
+        totals.push_back(std::accumulate(data.begin(), data.end(), 0LL));
+    }
+    std::vector<std::size_t> mismatches(4);
+    std::vector<std::thread> readers;
+    for (std::size_t t = 0; t < mismatches.size(); ++t) {
+        readers.emplace_back([&, t] {
+            for (std::size_t round = 0; round < 50; ++round) {
+                for (std::size_t version = 0; version < totals.size(); ++version) {
+                    mismatches[t] += tree.valueOnSegment(version, 0, data.size() - 1) != totals[version];
+                }
+            }
+        });
+    }
+    for (std::size_t i = 0; i < 20000; ++i) {
+        tree.changeValueAt(i % data.size(), static_cast<long long>(i));
+    }
+    for (auto &reader : readers) {
+        reader.join();
+    }
+    REQUIRE(std::accumulate(mismatches.begin(), mismatches.end(), std::size_t{0}) == 0);
+    REQUIRE(tree.versionCount() == totals.size() + 20000);
+
+}
+
+TEST_CASE("Wavelet matrix", "[data_structure]") {
+
+    std::vector<int> data(GENERATE(take(10, random(1, 300))));
+    auto range = GENERATE(1, 16, 1000000);
+    auto offset = GENERATE(0, -2000000000, 2000000000);
+    auto values = GENERATE(take(1, chunk(300, random(-1000000, 1000000))));
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        data[i] = values[i] % range + (offset < 0 ? offset + range : offset - range);
+    }
+    cpa::WaveletMatrix<int> wm(data.begin(), data.end());
+    REQUIRE(wm.size() == data.size());
+    for (std::size_t l = 0; l < data.size(); l += 1 + l / 8) {
+        for (std::size_t r = l; r < data.size(); r += 1 + r / 8) {
+            std::vector<int> sorted(data.begin() + l, data.begin() + r + 1);
+            std::sort(sorted.begin(), sorted.end());
+            for (std::size_t k = 0; k < sorted.size(); k += 1 + k / 4) {
+                REQUIRE(wm.kthSmallest(l, r, k) == sorted[k]);
+                auto less = std::lower_bound(sorted.begin(), sorted.end(), sorted[k]) - sorted.begin();
+                REQUIRE(wm.countLess(l, r, sorted[k]) == static_cast<std::size_t>(less));
+                REQUIRE(wm.rangeFreq(l, r, sorted[0], sorted[k] + 1) == static_cast<std::size_t>(
+                        std::upper_bound(sorted.begin(), sorted.end(), sorted[k]) - sorted.begin()));
+            }
+            REQUIRE(wm.countLess(l, r, std::numeric_limits<int>::max()) == sorted.size());
+            REQUIRE(wm.countLess(l, r, std::numeric_limits<int>::min()) == 0);
+        }
+        REQUIRE(wm.getValueAt(l) == data[l]);
+        REQUIRE(wm.rank(data[l], l + 1) ==
+                static_cast<std::size_t>(std::count(data.begin(), data.begin() + l + 1, data[l])));
+    }
+
+}
+
+TEST_CASE("Binary search descent", "[data_structure]") {
+
+    std::vector<long long> data(GENERATE(take(20, random(1, 300))));
+    auto values = GENERATE(take(1, chunk(300, random(0, 100))));
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        data[i] = values[i];
+    }
+    cpa::SegmentTree<long long, cpa::Sum<long long>> segment_tree(data.begin(), data.end());
+    cpa::FenwickTree<long long, cpa::Max<long long>> fenwick_tree(data.begin(), data.end());
+    for (long long bound : {0LL, 50LL, 99LL, 500LL, 100000LL}) {
+        auto sum_fits = [bound](long long x) { return x <= bound; };
+        auto max_fits = [bound](long long x) { return x <= bound / 5; };
+        for (std::size_t i = 0; i < data.size(); ++i) {
+            auto right = i;
+            for (long long sum = 0; right < data.size() && sum + data[right] <= bound; ++right) {
+                sum += data[right];
+            }
+            REQUIRE(segment_tree.maxRight(i, sum_fits) == right);
+            auto left = i + 1;
+            for (long long sum = 0; left > 0 && sum + data[left - 1] <= bound; --left) {
+                sum += data[left - 1];
+            }
+            REQUIRE(segment_tree.minLeft(i, sum_fits) == left);
+            right = std::find_if(data.begin() + i, data.end(), [&](long long x) { return !max_fits(x); }) -
+                    data.begin();
+            REQUIRE(fenwick_tree.maxRight(i, max_fits) == right);
+            left = i + 1;
+            while (left > 0 && max_fits(data[left - 1])) {
+                --left;
+            }
+            REQUIRE(fenwick_tree.minLeft(i, max_fits) == left);
+        }
+        REQUIRE(segment_tree.maxRight(data.size(), sum_fits) == data.size());
+        REQUIRE(fenwick_tree.maxRight(data.size(), max_fits) == data.size());
+    }
+
+}
+
+TEST_CASE("Wide segment tree point update", "[data_structure]") {
+
+    std::vector<int> data(GENERATE(1, 16, 17, 256, 5000));
+    auto operations = GENERATE(take(3, chunk(900, random(0, 1000000))));
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<int>(i * 2654435761u % 2001) - 1000;
+    }
+    cpa::WideSegmentTree<int, cpa::Sum<int>> sum_tree(data.begin(), data.end(), {}, 2);
+    cpa::WideSegmentTree<int, cpa::Max<int>, 8> max_tree(data.begin(), data.end());
+    REQUIRE(sum_tree.height() >= 1);
+    for (std::size_t i = 0; i + 2 < operations.size(); i += 3) {
+        auto l = operations[i] % data.size();
+        auto r = operations[i + 1] % data.size();
+        if (l > r) {
+            std::swap(l, r);
+        }
+        auto value = static_cast<int>(operations[i + 2] % 2001) - 1000;
+        sum_tree.changeValueAt(r, value);
+        max_tree.changeValueAt(r, value);
+        data[r] = value;
+        REQUIRE(sum_tree.getValueAt(r) == value);
+        REQUIRE(sum_tree.valueOnSegment(l, r) == std::accumulate(data.begin() + l, data.begin() + r + 1, 0));
+        REQUIRE(max_tree.valueOnSegment(l, r) == *std::max_element(data.begin() + l, data.begin() + r + 1));
+    }
+
+}
+
+TEST_CASE("Rectangle query", "[data_structure]") {
+
+    std::size_t rows = GENERATE(1, 2, 7, 20);
+    std::size_t columns = GENERATE(1, 3, 16, 25);
+    auto values = GENERATE(take(2, chunk(500, random(-1000, 1000))));
+    std::vector<long long> grid(values.begin(), values.begin() + rows * columns);
+    auto brute = [&](std::size_t r1, std::size_t c1, std::size_t r2, std::size_t c2, bool minimum) {
+        auto result = minimum ? grid[r1 * columns + c1] : 0LL;
+        for (auto i = r1; i <= r2; ++i) {
+            for (auto j = c1; j <= c2; ++j) {
+                result = minimum ? std::min(result, grid[i * columns + j]) : result + grid[i * columns + j];
+            }
+        }
+        return result;
+    };
+
+    cpa::FenwickTree2D<long long> fenwick(grid.begin(), grid.end(), columns);
+    cpa::SegmentTree2D<long long, cpa::Sum<long long>> segment_tree(grid.begin(), grid.end(), columns);
+    cpa::SparseTable2D<long long, cpa::Min<long long>> sparse_table(grid.begin(), grid.end(), columns);
+    cpa::SegmentTree2D<long long, cpa::Min<long long>> min_tree(grid.begin(), grid.end(), columns);
+    REQUIRE(fenwick.rows() == rows);
+    REQUIRE(sparse_table.columns() == columns);
+    for (std::size_t step = 0; step < 3; ++step) {
+        for (std::size_t r1 = 0; r1 < rows; ++r1) {
+            for (std::size_t r2 = r1; r2 < rows; r2 += 1 + r2 / 4) {
+                for (std::size_t c1 = 0; c1 < columns; c1 += 1 + c1 / 4) {
+                    for (std::size_t c2 = c1; c2 < columns; c2 += 1 + c2 / 4) {
+                        REQUIRE(fenwick.valueOnRectangle(r1, c1, r2, c2) == brute(r1, c1, r2, c2, false));
+                        REQUIRE(segment_tree.valueOnRectangle(r1, c1, r2, c2) == brute(r1, c1, r2, c2, false));
+                        REQUIRE(min_tree.valueOnRectangle(r1, c1, r2, c2) == brute(r1, c1, r2, c2, true));
+                        if (step == 0) {
+                            REQUIRE(sparse_table.valueOnRectangle(r1, c1, r2, c2) == brute(r1, c1, r2, c2, true));
+                        }
+                    }
+                }
+            }
+        }
+        auto row = values[step] % rows;
+        auto column = values[step + 3] % columns;
+        auto value = values[step + 6];
+        grid[row * columns + column] = value;
+        fenwick.changeValueAt(row, column, value);
+        segment_tree.changeValueAt(row, column, value);
+        min_tree.changeValueAt(row, column, value);
+        REQUIRE(fenwick.getValueAt(row, column) == value);
+        REQUIRE(segment_tree.getValueAt(row, column) == value);
+    }
+
+}
+
+TEST_CASE("Compressed rectangle query", "[data_structure]") {
+
+    auto values = GENERATE(take(10, chunk(600, random(-1000000000, 1000000000))));
+    std::vector<std::pair<long long, long long>> points;
+    for (std::size_t i = 0; i + 1 < 400; i += 2) {
+        points.emplace_back(values[i] % 50, values[i + 1]);
+    }
+    cpa::CompressedFenwickTree2D<long long> tree(points.begin(), points.end());
+    std::vector<long long> weights(points.size());
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        weights[i] = values[400 + i] % 1000;
+        tree.addValueAt(points[i].first, points[i].second, weights[i]);
+    }
+    for (std::size_t q = 0; q + 3 < 600; q += 4) {
+        auto x1 = values[q] % 60, x2 = values[q + 1] % 60;
+        auto y1 = values[q + 2], y2 = values[q + 3];
+        if (x1 > x2) {
+            std::swap(x1, x2);
+        }
+        if (y1 > y2) {
+            std::swap(y1, y2);
+        }
+        long long expected = 0;
+        for (std::size_t i = 0; i < points.size(); ++i) {
+            if (x1 <= points[i].first && points[i].first <= x2 && y1 <= points[i].second && points[i].second <= y2) {
+                expected += weights[i];
+            }
+        }
+        REQUIRE(tree.valueOnRectangle(x1, y1, x2, y2) == expected);
+        REQUIRE(tree.valueOnRectangle(points[q / 4].first, points[q / 4].second, points[q / 4].first,
+                                      points[q / 4].second) ==
+                std::accumulate(weights.begin(), weights.end(), 0LL, [&](long long sum, const long long &w) {
+                    auto i = &w - weights.data();
+                    return points[i] == points[q / 4] ? sum + w : sum;
+                }));
+    }
+
+    std::vector<std::pair<long long, long long>> corners = {{0, 0}, {10, 10}};
+    cpa::CompressedFenwickTree2D<long long> sparse(corners.begin(), corners.end());
+    REQUIRE_THROWS_AS(sparse.addValueAt(5, 5, 7), std::out_of_range);
+    REQUIRE_THROWS_AS(sparse.addValueAt(0, 10, 7), std::out_of_range);
+    REQUIRE_THROWS_AS(sparse.addValueAt(11, 11, 7), std::out_of_range);
+    REQUIRE(sparse.valueOnRectangle(0, 0, 6, 6) == 0);
+    REQUIRE(sparse.valueOnRectangle(10, 10, 10, 10) == 0);
+    sparse.addValueAt(10, 10, 7);
+    REQUIRE(sparse.valueOnRectangle(10, 10, 10, 10) == 7);
+
+}
+
+TEST_CASE("Mo's algorithm", "[offline]") {
+
+    std::size_t size = GENERATE(1, 10, 300);
+    auto values = GENERATE(take(5, chunk(1200, random(0, 1000000))));
+    std::vector<int> data(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        data[i] = values[i] % 20;
+    }
+    std::vector<int> count(20);
+    std::size_t distinct = 0;
+    auto add = [&](std::size_t i) {
+        distinct += count[data[i]]++ == 0;
+    };
+    auto remove = [&](std::size_t i) {
+        distinct -= --count[data[i]] == 0;
+    };
+    auto brute = [&](std::size_t l, std::size_t r) {
+        std::vector<int> seen(data.begin() + l, data.begin() + r + 1);
+        std::sort(seen.begin(), seen.end());
+        return static_cast<std::size_t>(std::unique(seen.begin(), seen.end()) - seen.begin());
+    };
+
+    SECTION("static array") {
+        std::vector<std::pair<std::size_t, std::size_t>> queries;
+        for (std::size_t i = 300; i + 1 < 1200; i += 2) {
+            auto l = values[i] % size, r = values[i + 1] % size;
+            queries.emplace_back(std::min(l, r), std::max(l, r));
+        }
+        std::vector<std::size_t> answers(queries.size());
+        cpa::solveMo(queries, add, remove, [&](std::size_t q) {
+            answers[q] = distinct;
+        });
+        for (std::size_t q = 0; q < queries.size(); ++q) {
+            REQUIRE(answers[q] == brute(queries[q].first, queries[q].second));
+        }
+    }
+
+    SECTION("array with point updates") {
+        std::vector<std::tuple<std::size_t, std::size_t, std::size_t>> queries;
+        std::vector<std::size_t> positions;
+        std::vector<int> new_values;
+        std::vector<std::size_t> expected;
+        auto original = data;
+        for (std::size_t i = 300; i + 2 < 1200; i += 3) {
+            if (values[i] % 3 == 0) {
+                positions.push_back(values[i + 1] % size);
+                new_values.push_back(values[i + 2] % 20);
+                data[positions.back()] = new_values.back();
+                continue;
+            }
+            auto l = values[i + 1] % size, r = values[i + 2] % size;
+            queries.emplace_back(std::min(l, r), std::max(l, r), positions.size());
+            expected.push_back(brute(std::min(l, r), std::max(l, r)));
+        }
+        data = original;
+        std::vector<std::size_t> answers(queries.size());
+        cpa::solveMoWithUpdates(queries, positions, add, remove, [&](std::size_t u) {
+            std::swap(data[positions[u]], new_values[u]);
+        }, [&](std::size_t q) {
+            answers[q] = distinct;
+        });
+        REQUIRE(answers == expected);
+    }
+
+}
+
+TEST_CASE("Concurrent segment tree", "[data_structure]") {
+
+    std::vector<long long> data(GENERATE(1, 17, 1000));
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<long long>(i * 2654435761u % 2001) - 1000;
+    }
+
+    SECTION("single thread") {
+        auto operations = GENERATE(take(3, chunk(900, random(0, 1000000))));
+        cpa::ConcurrentSegmentTree<long long, cpa::Sum<long long>> ds(data.begin(), data.end());
+        for (std::size_t i = 0; i + 2 < operations.size(); i += 3) {
+            auto l = operations[i] % data.size();
+            auto r = operations[i + 1] % data.size();
+            if (l > r) {
+                std::swap(l, r);
+            }
+            data[r] = operations[i + 2] % 2001 - 1000;
+            ds.changeValueAt(r, data[r]);
+            REQUIRE(ds.getValueAt(r) == data[r]);
+            REQUIRE(ds.valueOnSegment(l, r) == std::accumulate(data.begin() + l, data.begin() + r + 1, 0LL));
+        }
+    }
+
+    SECTION("readers during updates") {
+        std::fill(data.begin(), data.end(), 0);
+        cpa::ConcurrentSegmentTree<long long, cpa::Sum<long long>> ds(data.begin(), data.end());
+        constexpr long long rounds = 20;
+        std::atomic<bool> failed{false};
+        std::vector<std::thread> readers;
+        for (int t = 0; t < 3; ++t) {
+            readers.emplace_back([&]() {
+                long long previous = 0;
+                for (int q = 0; q < 20000; ++q) {
+                    auto current = ds.valueOnSegment(0, data.size() - 1);
+                    if (current < previous || current > rounds * static_cast<long long>(data.size())) {
+                        failed = true;
+                    }
+                    previous = current;
+                }
+            });
+        }
+        for (long long round = 1; round <= rounds; ++round) {
+            for (std::size_t i = 0; i < data.size(); ++i) {
+                ds.changeValueAt(i, round);
+            }
+        }
+        for (auto &reader : readers) {
+            reader.join();
+        }
+        REQUIRE_FALSE(failed);
+        REQUIRE(ds.valueOnSegment(0, data.size() - 1) == rounds * static_cast<long long>(data.size()));
+    }
+
+}
+
+TEST_CASE("Adaptive solver", "[data_structure]") {
+
+    REQUIRE(cpa::chooseSolverKind<cpa::Min<int>>(10, 0.5, 5) == cpa::SolverKind::Array);
+    REQUIRE(cpa::chooseSolverKind<cpa::Min<int>>(1000, 0, 300) == cpa::SolverKind::SparseTable);
+    REQUIRE(cpa::chooseSolverKind<cpa::Sum<int>>(1000, 0, 300) == cpa::SolverKind::DisjointSparseTable);
+    REQUIRE(cpa::chooseSolverKind<cpa::Sum<int>>(1000, 0.5, 300) == cpa::SolverKind::FenwickTree);
+    REQUIRE(cpa::chooseSolverKind<cpa::Sum<int>>(1000, 0.95, 300) == cpa::SolverKind::SqrtDecomposer);
+    REQUIRE(cpa::chooseSolverKind<cpa::Min<int>>(1000, 0.5, 300) == cpa::SolverKind::SegmentTree);
+    REQUIRE(cpa::chooseSolverKind<cpa::Min<int>>(1000, 0.5, 8) == cpa::SolverKind::Array);
+    REQUIRE(cpa::chooseSolverKind<std::function<int(const int &, const int &)>>(1000, 0.5, 300) ==
+            cpa::SolverKind::SqrtDecomposer);
+
+    std::vector<long long> data(GENERATE(100, 2000));
+    auto operations = GENERATE(take(3, chunk(300, random(0, 1000000))));
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<long long>(i * 2654435761u % 2001) - 1000;
+    }
+    auto ds = cpa::makeSegmentSolver<long long, cpa::Min<long long>>(data.begin(), data.end());
+    REQUIRE(ds.kind() == cpa::SolverKind::SparseTable);
+    auto check = [&](std::size_t l, std::size_t r) {
+        if (l > r) {
+            std::swap(l, r);
+        }
+        REQUIRE(ds.valueOnSegment(l, r) == *std::min_element(data.begin() + l, data.begin() + r + 1));
+    };
+    for (std::size_t i = 0; i + 2 < operations.size(); i += 3) {
+        auto index = operations[i] % data.size();
+        data[index] = static_cast<long long>(operations[i + 1] % 2001) - 1000;
+        ds.changeValueAt(index, data[index]);
+        REQUIRE(ds.getValueAt(index) == data[index]);
+        check(operations[i + 1] % data.size(), operations[i + 2] % data.size());
+    }
+    REQUIRE(ds.kind() != cpa::SolverKind::SparseTable);
+    for (std::size_t i = 0; i < 2 * std::max<std::size_t>(1024, data.size()); ++i) {
+        check(operations[i % operations.size()] % data.size(), operations[(i + 1) % operations.size()] % data.size());
+    }
+    REQUIRE(ds.kind() == cpa::SolverKind::SparseTable);
+    REQUIRE(ds.migrations() >= 2);
+
+    auto sum = cpa::makeSegmentSolver<long long, cpa::Sum<long long>>(data.begin(), data.end(), {}, 0.5,
+                                                                      static_cast<double>(data.size()) / 2);
+    cpa::SegmentTree<long long, cpa::Sum<long long>> reference(data.begin(), data.end());
+    REQUIRE(sum.kind() == (data.size() > 64 ? cpa::SolverKind::FenwickTree : cpa::SolverKind::Array));
+    for (std::size_t i = 0; i + 2 < operations.size(); i += 3) {
+        auto index = operations[i] % data.size();
+        auto value = static_cast<long long>(operations[i + 1] % 2001) - 1000;
+        sum.changeValueAt(index, value);
+        sum.changeValueAt(index, value);
+        reference.changeValueAt(index, value);
+        REQUIRE(sum.getValueAt(index) == value);
+        REQUIRE(sum.valueOnSegment(0, data.size() - 1) == reference.valueOnSegment(0, data.size() - 1));
+    }
+    for (auto kind : {cpa::SolverKind::Array, cpa::SolverKind::SegmentTree, cpa::SolverKind::SqrtDecomposer,
+                      cpa::SolverKind::FenwickTree}) {
+        sum.rebuild(kind);
+        sum.changeValueAt(0, 10);
+        sum.changeValueAt(0, 10);
+        reference.changeValueAt(0, 10);
+        REQUIRE(sum.getValueAt(0) == 10);
+        REQUIRE(sum.valueOnSegment(0, data.size() - 1) == reference.valueOnSegment(0, data.size() - 1));
+    }
+
+}
+
+TEST_CASE("Instrumentation", "[stats]") {
+
+    REQUIRE(std::is_empty_v<cpa::NoStats>);
+    REQUIRE(cpa::MonoidTraits<cpa::Instrumented<cpa::Sum<int>>>::invertible);
+    REQUIRE(cpa::MonoidTraits<cpa::Instrumented<cpa::Min<int>>>::idempotent);
+
+    std::vector<int> data{5, -3, 8, 1, 0, 7, -2, 4};
+    cpa::Instrumented<cpa::Sum<int>> sum(cpa::CountingStats("segment tree"));
+    cpa::SegmentTree<int, cpa::Instrumented<cpa::Sum<int>>> st(data.begin(), data.end(), sum);
+    REQUIRE(st.stats().rebuilds == 1);
+    REQUIRE(st.stats().allocated_bytes == 2 * data.size() * sizeof(int));
+    REQUIRE(st.stats().combines == data.size() - 1);
+    sum.reset();
+    REQUIRE(st.valueOnSegment(1, 6) == 11);
+    REQUIRE(st.stats().combines > 0);
+    REQUIRE(st.stats().combines <= 6);
+
+    cpa::Instrumented<cpa::Min<int>> min(cpa::CountingStats("sparse table"));
+    cpa::SparseTable<int, cpa::Instrumented<cpa::Min<int>>> sparse(data.begin(), data.end(), min);
+    auto built = sparse.stats().combines.load();
+    REQUIRE(sparse.valueOnSegment(0, 7) == -3);
+    REQUIRE(sparse.stats().combines == built + 1);
+
+    cpa::Graph<cpa::Edge, int, cpa::CountingStats> g(5, true, cpa::CountingStats("graph"));
+    g.addEdge(cpa::Edge(2, 1));
+    g.addEdge(cpa::Edge(1, 4));
+    g.addEdge(cpa::Edge(0, 3));
+    g.addEdge(cpa::Edge(3, 4));
+    REQUIRE(g.topologicalSort().size() == 5);
+    REQUIRE(g.stats().visits == 4);
+    REQUIRE(g.stats().allocated_bytes == 5);
+
+    std::ostringstream out;
+    cpa::StatsRegistry::instance().dump(out);
+    REQUIRE(out.str().find("\"name\": \"graph\", \"combines\": 0, \"visits\": 4") != std::string::npos);
+    REQUIRE(out.str().find("\"segment tree\"") != std::string::npos);
+
+    for (int i = 0; i < 100000; ++i) {
+        cpa::SegmentTree<int, cpa::Instrumented<cpa::Sum<int>>> transient(data.begin(), data.end());
+        REQUIRE(transient.valueOnSegment(0, 1) == 2);
+    }
+    REQUIRE(cpa::StatsRegistry::instance().size() < 1000);
+
+}
+
+TEST_CASE("Snapshot", "[data_structure]") {
+
+    std::vector<long long> data(GENERATE(1, 7, 1000));
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<long long>(i * 2654435761u % 2001) - 1000;
+    }
+    const std::string path = "cpa_snapshot_test.bin";
+
+    SECTION("sparse table") {
+        cpa::SparseTable<long long, cpa::Min<long long>> built(data.begin(), data.end());
+        built.save(path);
+        auto opened = cpa::SparseTable<long long, cpa::Min<long long>>::open(path);
+        REQUIRE(opened.size() == data.size());
+        auto copy = opened;
+        for (std::size_t l = 0; l < data.size(); l += 1 + l / 3) {
+            for (std::size_t r = l; r < data.size(); r += 1 + r / 5) {
+                REQUIRE(opened.valueOnSegment(l, r) == built.valueOnSegment(l, r));
+                REQUIRE(copy.valueOnSegment(l, r) == built.valueOnSegment(l, r));
+            }
+        }
+        REQUIRE_THROWS_AS((cpa::SegmentTree<long long, cpa::Min<long long>>::open(path)), std::runtime_error);
+        REQUIRE_THROWS_AS((cpa::SparseTable<int, cpa::Min<int>>::open(path)), std::runtime_error);
+        cpa::SparseTable<long long, cpa::Min<long long>> shorter(data.begin(), data.begin() + 1);
+        shorter.save(path);
+        for (std::size_t l = 0; l < data.size(); l += 1 + l / 3) {
+            REQUIRE(opened.valueOnSegment(l, data.size() - 1) == built.valueOnSegment(l, data.size() - 1));
+        }
+        REQUIRE(cpa::SparseTable<long long, cpa::Min<long long>>::open(path).size() == 1);
+        cpa::SnapshotHeader header{};
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.read(reinterpret_cast<char *>(&header), sizeof(header));
+        header.levels = 64;
+        file.seekp(0);
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        file.close();
+        REQUIRE_THROWS_AS((cpa::SparseTable<long long, cpa::Min<long long>>::open(path)), std::runtime_error);
+    }
+
+    SECTION("segment tree") {
+        cpa::SegmentTree<long long, cpa::Sum<long long>> built(data.begin(), data.end());
+        built.save(path);
+        {
+            auto opened = cpa::SegmentTree<long long, cpa::Sum<long long>>::open(path);
+            REQUIRE(opened.valueOnSegment(0, data.size() - 1) == built.valueOnSegment(0, data.size() - 1));
+            opened.changeValueAt(data.size() / 2, 12345);
+            data[data.size() / 2] = 12345;
+            REQUIRE(opened.valueOnSegment(0, data.size() - 1) ==
+                    std::accumulate(data.begin(), data.end(), 0ll));
+        }
+        auto reopened = cpa::SegmentTree<long long, cpa::Sum<long long>>::open(path);
+        REQUIRE(reopened.valueOnSegment(0, data.size() - 1) == built.valueOnSegment(0, data.size() - 1));
+        cpa::SnapshotHeader header{};
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.read(reinterpret_cast<char *>(&header), sizeof(header));
+        header.size = std::uint64_t{1} << 63u;
+        header.data_count = 0;
+        file.seekp(0);
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        file.close();
+        REQUIRE_THROWS_AS((cpa::SegmentTree<long long, cpa::Sum<long long>>::open(path)), std::runtime_error);
+    }
+
+    std::ofstream(path, std::ios::binary | std::ios::trunc) << "CPASNAP";
+    REQUIRE_THROWS_AS((cpa::SparseTable<long long, cpa::Min<long long>>::open(path)), std::runtime_error);
+    std::remove(path.c_str());
+    REQUIRE_THROWS_AS((cpa::SparseTable<long long, cpa::Min<long long>>::open(path)), std::runtime_error);
+
+}